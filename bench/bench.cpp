@@ -0,0 +1,588 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "astar.hpp"
+#include "jps.hpp"
+#include "jpsplus.hpp"
+#include "bidirectional.hpp"
+#include "hpa.hpp"
+#include "dstarlite.hpp"
+#include "batch.hpp"
+#include "hda.hpp"
+#include "pathcache.hpp"
+#include "bucketqueue.hpp"
+#include "gridastar.hpp"
+#include "landmarks.hpp"
+#include "components.hpp"
+#include "bitbfs.hpp"
+#include "flowfield.hpp"
+#include "cbs.hpp"
+#include "whca.hpp"
+#include "thetastar.hpp"
+#include "arastar.hpp"
+
+// Benchmark of the A* search: the former bubbleSort/removeFirst open set
+// against the core library, reported as node expansions per second
+
+typedef struct Cell {
+  int f, g, h;
+  Coord parent;
+} Cell;
+
+// Random board with the given percentage of walls
+Board makeBoard(int width, int height, unsigned int seed, int walls = 25) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(0, 99);
+  Board board(width, height);
+  for (int i=0; i<width*height; i++) {
+    if (dist(rng) < walls) board.c[i].status = Board::WALL;
+  }
+  board.cell({0, 0}).status = Board::EMPTY;
+  board.cell({width-1, height-1}).status = Board::EMPTY;
+  return board;
+}
+
+// Long horizontal walls every 8 rows, each with one gap at alternating ends
+Board makeMaze(int width, int height) {
+  Board board(width, height);
+  for (int y=4; y<height; y+=8) {
+    for (int x=0; x<width; x++) {
+      board.cell({x, y}).status = Board::WALL;
+    }
+    board.cell({(y/8) % 2 ? 0 : width-1, y}).status = Board::EMPTY;
+  }
+  return board;
+}
+
+int heuristic(Coord a, Coord b) {
+  return abs(a.x-b.x) + abs(a.y-b.y);
+}
+
+bool isIn(const std::vector<Coord>& arr, int n, Coord c) {
+  for (int i=0; i<n; i++) {
+    if (arr[i].x == c.x && arr[i].y == c.y) return true;
+  }
+  return false;
+}
+
+// The original open set: the whole array is bubble sorted before every pop
+int solveLegacy(const Board& board, Coord start, Coord end) {
+  std::vector<Cell> c(board.width*board.height);
+  std::vector<Coord> openSet(board.width*board.height), closedSet(board.width*board.height);
+  int openCount = 0, closedCount = 0, expanded = 0;
+  for (int i=0; i<(int)c.size(); i++) {
+    c[i].f = c[i].g = c[i].h = 2147483647;
+  }
+
+  c[board.index(start)].g = 0;
+  c[board.index(start)].f = heuristic(start, end);
+  openSet[openCount++] = start;
+  while (openCount > 0) {
+    for (int i=0; i<openCount-1; i++) {
+      for (int j=0; j<openCount-i-1; j++) {
+        if (c[board.index(openSet[j])].f > c[board.index(openSet[j+1])].f) {
+          Coord temp = openSet[j];
+          openSet[j] = openSet[j+1];
+          openSet[j+1] = temp;
+        }
+      }
+    }
+    Coord cur = openSet[0];
+    for (int i=0; i<openCount-1; i++) openSet[i] = openSet[i+1];
+    openCount--;
+    closedSet[closedCount++] = cur;
+    expanded++;
+    if (cur.x == end.x && cur.y == end.y) break;
+
+    Coord next[4] = {{cur.x-1, cur.y}, {cur.x+1, cur.y}, {cur.x, cur.y-1}, {cur.x, cur.y+1}};
+    for (int k=0; k<4; k++) {
+      Coord nb = next[k];
+      if (!board.inside(nb) || board.isWall(nb) || isIn(closedSet, closedCount, nb)) continue;
+      int g = c[board.index(cur)].g + 1;
+      int h = heuristic(nb, end);
+      bool open = isIn(openSet, openCount, nb);
+      if (!open || g + h < c[board.index(nb)].f) {
+        c[board.index(nb)].g = g;
+        c[board.index(nb)].h = h;
+        c[board.index(nb)].f = g + h;
+        c[board.index(nb)].parent = cur;
+        if (!open) openSet[openCount++] = nb;
+      }
+    }
+  }
+  return expanded;
+}
+
+// The library search, an indexed binary heap with per-cell membership flags
+int solveCore(const Board& board, Coord start, Coord end) {
+  AStar search(board);
+  search.findPath(start, end);
+  return search.expanded;
+}
+
+// The A* loop of the library over either open set, to time them side by side
+template <class Queue>
+int solveWith(const Board& board, Coord start, Coord end) {
+  std::vector<int> g(board.width*board.height, 2147483647);
+  std::vector<bool> closed(board.width*board.height, false);
+  Queue openSet(board.width*board.height);
+  int expanded = 0;
+  g[board.index(start)] = 0;
+  openSet.push(board.index(start), board.heuristic(start, end), board.heuristic(start, end));
+  while (!openSet.empty()) {
+    int id = openSet.pop();
+    closed[id] = true;
+    expanded++;
+    if (id == board.index(end)) break;
+
+    Coord cur = board.coord(id);
+    Coord next[4] = {{cur.x-1, cur.y}, {cur.x+1, cur.y}, {cur.x, cur.y-1}, {cur.x, cur.y+1}};
+    for (int k=0; k<4; k++) {
+      if (!board.isFree(next[k]) || closed[board.index(next[k])]) continue;
+      int nb = board.index(next[k]);
+      int h = board.heuristic(next[k], end);
+      if (g[nb] == 2147483647) {
+        g[nb] = g[id] + 1;
+        openSet.push(nb, g[nb] + h, h);
+      } else if (g[id] + 1 < g[nb]) {
+        g[nb] = g[id] + 1;
+        openSet.decrease(nb, g[nb] + h, h);
+      }
+    }
+  }
+  return expanded;
+}
+
+void report(const char* name, int size, int (*solve)(const Board&, Coord, Coord)) {
+  Board board = makeBoard(size, size, 42);
+  auto begin = std::chrono::steady_clock::now();
+  int expanded = solve(board, {0, 0}, {size-1, size-1});
+  auto finish = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(finish - begin).count();
+  std::cout << name << " " << size << "x" << size << ": " << expanded << " expansions, "
+            << seconds * 1000.0 << " ms, " << (long)(expanded / seconds) << " expansions/sec" << std::endl;
+}
+
+// Expansions and time of one solver on a query
+void compare(const char* name, AStar& solver, Coord start, Coord end) {
+  auto begin = std::chrono::steady_clock::now();
+  std::vector<Coord> path = solver.findPath(start, end);
+  auto finish = std::chrono::steady_clock::now();
+  double seconds = std::chrono::duration<double>(finish - begin).count();
+  std::cout << name << ": " << solver.expanded << " expansions, " << path.size() << " cells, "
+            << seconds * 1000.0 << " ms" << std::endl;
+}
+
+// Euclidean length of a path through the given cells
+double lengthOf(const std::vector<Coord>& path) {
+  double length = 0;
+  for (int i=1; i<(int)path.size(); i++) {
+    length += std::hypot((double)(path[i].x - path[i-1].x), (double)(path[i].y - path[i-1].y));
+  }
+  return length;
+}
+
+int main(void) {
+  int sizes[] = {32, 64, 128};
+  for (int i=0; i<3; i++) {
+    report("[legacy]", sizes[i], solveLegacy);
+    report("[core]  ", sizes[i], solveCore);
+  }
+
+  // Binary heap against buckets indexed by fScore, AStar uses the heap unless
+  // built with ASTAR_BUCKET_QUEUE
+  Board queued = makeBoard(1024, 1024, 3, 20);
+  int (*queues[])(const Board&, Coord, Coord) = {solveWith<OpenSet>, solveWith<BucketQueue>};
+  const char* queueNames[] = {"[heap]  ", "[bucket]"};
+  std::cout << "Open set on a 1024x1024 map, 20% walls" << std::endl;
+  for (int i=0; i<2; i++) {
+    auto begin = std::chrono::steady_clock::now();
+    int expanded = queues[i](queued, {0, 0}, {1023, 1023});
+    auto finish = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(finish - begin).count();
+    std::cout << queueNames[i] << ": " << expanded << " expansions, " << seconds * 1000.0 << " ms, "
+              << (long)(expanded / seconds) << " expansions/sec" << std::endl;
+  }
+
+  // Unit costs, so a breadth-first wavefront over 64 cells per word finds the same distance
+  BitBFS bitboard(queued);
+  bitboard.trace = false;
+  compare("[bits]  ", bitboard, {0, 0}, {1023, 1023});
+
+  // Open map, where jump points prune most symmetric paths
+  Board open = makeBoard(1024, 1024, 42, 1);
+  AStar search(open);
+  JPS jpsFour(open, JPS::FOUR);
+  JPS jpsEight(open, JPS::EIGHT);
+  std::cout << "Open 1024x1024 map, 1% walls" << std::endl;
+  compare("[A*]    ", search, {0, 0}, {1023, 1023});
+  GridAStar<8> octile(open);
+  compare("[A*8]   ", octile, {0, 0}, {1023, 1023});
+  ThetaStar theta(open);
+  ThetaStar lazyTheta(open, true);
+  compare("[Theta*]", theta, {0, 0}, {1023, 1023});
+  compare("[Lazy]  ", lazyTheta, {0, 0}, {1023, 1023});
+  std::cout << "[A*8]     length " << lengthOf(octile.path()) << std::endl;
+  ThetaStar* anyAngle[] = {&theta, &lazyTheta};
+  for (int i=0; i<2; i++) {
+    std::vector<Coord> corners = anyAngle[i]->waypoints();
+    std::cout << (i ? "[Lazy]  " : "[Theta*]") << "  length " << lengthOf(corners) << " in " << corners.size() - 1
+              << " segments, " << anyAngle[i]->sightChecks << " sight checks" << std::endl;
+  }
+  compare("[JPS4]  ", jpsFour, {0, 0}, {1023, 1023});
+  compare("[JPS8]  ", jpsEight, {0, 0}, {1023, 1023});
+
+  // JPS+ pays for its table once, then every scan is a lookup
+  auto begin = std::chrono::steady_clock::now();
+  JumpTable table(open);
+  auto finish = std::chrono::steady_clock::now();
+  std::cout << "[JPS+]   table: " << table.d.size()*sizeof(short) / 1024 << " KiB, "
+            << std::chrono::duration<double>(finish - begin).count() * 1000.0 << " ms" << std::endl;
+  JPSPlus jpsPlus(open, table);
+  compare("[JPS+]  ", jpsPlus, {0, 0}, {1023, 1023});
+
+  // Long queries across a cluttered map, searched from one or both ends
+  Board cluttered = makeBoard(512, 512, 7, 30);
+  AStar forward(cluttered);
+  BidirectionalAStar both(cluttered);
+  long forwardTotal = 0, bothTotal = 0;
+  std::mt19937 rng(7);
+  std::cout << "Cluttered 512x512 map, 30% walls, 20 long queries" << std::endl;
+  for (int q=0; q<20; q++) {
+    Coord start = {(int)(rng() % 64), (int)(rng() % 512)};
+    Coord end = {511 - (int)(rng() % 64), (int)(rng() % 512)};
+    if (cluttered.isWall(start) || cluttered.isWall(end)) continue;
+    forward.findPath(start, end);
+    both.findPath(start, end);
+    forwardTotal += forward.expanded;
+    bothTotal += both.expanded;
+  }
+  std::cout << "[A*]    : " << forwardTotal << " expansions" << std::endl;
+  std::cout << "[Bidir] : " << bothTotal << " expansions, "
+            << 100.0 * (forwardTotal - bothTotal) / forwardTotal << "% fewer" << std::endl;
+
+  // Large map, the abstract graph is built once and updated per toggled cell
+  Board large = makeBoard(2048, 2048, 11, 20);
+  begin = std::chrono::steady_clock::now();
+  HPA hpa(large);
+  finish = std::chrono::steady_clock::now();
+  std::cout << "Large 2048x2048 map, 20% walls" << std::endl;
+  std::cout << "[HPA*]   graph: " << hpa.owner.size() << " entrances, "
+            << std::chrono::duration<double>(finish - begin).count() * 1000.0 << " ms" << std::endl;
+  AStar flat(large);
+  double flatTime = 0, hpaTime = 0;
+  long flatLength = 0, hpaLength = 0;
+  for (int q=0; q<10; q++) {
+    Coord start = {(int)(rng() % 256), (int)(rng() % 2048)};
+    Coord end = {2047 - (int)(rng() % 256), (int)(rng() % 2048)};
+    if (large.isWall(start) || large.isWall(end)) continue;
+    begin = std::chrono::steady_clock::now();
+    flatLength += flat.findPath(start, end).size();
+    finish = std::chrono::steady_clock::now();
+    flatTime += std::chrono::duration<double>(finish - begin).count();
+    begin = std::chrono::steady_clock::now();
+    hpaLength += hpa.findPath(start, end).size();
+    finish = std::chrono::steady_clock::now();
+    hpaTime += std::chrono::duration<double>(finish - begin).count();
+  }
+  std::cout << "[A*]    : " << flatTime * 1000.0 << " ms, " << flatLength << " cells" << std::endl;
+  std::cout << "[HPA*]  : " << hpaTime * 1000.0 << " ms, " << hpaLength << " cells" << std::endl;
+  large.cell({1000, 1000}).status = Board::WALL;
+  begin = std::chrono::steady_clock::now();
+  hpa.update({1000, 1000});
+  hpa.refresh();
+  finish = std::chrono::steady_clock::now();
+  std::cout << "[HPA*]   update after a toggle: "
+            << std::chrono::duration<double>(finish - begin).count() * 1000.0 << " ms" << std::endl;
+
+  // Walls dropped one at a time on the current path, replanned by D* Lite
+  // against a search from scratch
+  Board edited = makeBoard(512, 512, 5, 20);
+  DStarLite dstar(edited);
+  AStar scratch(edited);
+  dstar.findPath({0, 0}, {511, 511});
+  std::cout << "Edited 512x512 map, 20% walls, 20 walls added on the path" << std::endl;
+  std::cout << "[D*Lite] first plan: " << dstar.expanded << " expansions" << std::endl;
+  long replanned = 0, scratched = 0;
+  for (int q=0; q<20; q++) {
+    std::vector<Coord> route = dstar.path();
+    if (route.size() < 3) break;
+    Coord wall = route[route.size() / 2];
+    edited.cell(wall).status = Board::WALL;
+    dstar.update(wall);
+    dstar.findPath({0, 0}, {511, 511});
+    scratch.findPath({0, 0}, {511, 511});
+    replanned += dstar.expanded;
+    scratched += scratch.expanded;
+  }
+  std::cout << "[A*]    : " << scratched << " expansions" << std::endl;
+  std::cout << "[D*Lite]: " << replanned << " expansions" << std::endl;
+
+  // Terrain: roads every 32 cells at cost 1, mud elsewhere at cost 4
+  Board terrain = makeBoard(512, 512, 13, 10);
+  for (int i=0; i<512*512; i++) {
+    Coord a = terrain.coord(i);
+    if (a.x % 32 != 0 && a.y % 32 != 0) terrain.setCost(a, 4);
+  }
+  AStar weighted(terrain);
+  std::cout << "Terrain 512x512 map, roads at cost 1 and mud at cost 4" << std::endl;
+  compare("[A*]    ", weighted, {0, 0}, {511, 511});
+  int roads = 0;
+  std::vector<Coord> route = weighted.path();
+  for (int i=0; i<(int)route.size(); i++) {
+    if (terrain.cell(route[i]).cost == 1) roads++;
+  }
+  std::cout << "[A*]     " << roads << " of " << route.size() << " cells on roads" << std::endl;
+
+  // Maze of long walls, where the Manhattan distance is far too optimistic
+  Board maze = makeMaze(512, 512);
+  LandmarkTable landmarks(maze, 8);
+  AStar manhattan(maze);
+  ALTAStar alt(maze, landmarks);
+  std::cout << "Maze 512x512 map, long walls every 8 rows" << std::endl;
+  std::cout << "[ALT]    " << landmarks.landmarks.size() << " landmarks: " << landmarks.bytes() / 1024 << " KiB, "
+            << landmarks.buildTime * 1000.0 << " ms" << std::endl;
+  compare("[A*]    ", manhattan, {256, 0}, {256, 511});
+  compare("[ALT]   ", alt, {256, 0}, {256, 511});
+  BitBFS mazeBits(maze);
+  mazeBits.trace = false;
+  compare("[bits]  ", mazeBits, {256, 0}, {256, 511});
+
+  // Independent queries on one map, solved by one worker and by the whole pool
+  Board shared = makeBoard(1024, 1024, 3, 20);
+  std::vector<BatchSolver::Query> queries;
+  for (int q=0; q<400; q++) {
+    Coord start = {(int)(rng() % 1024), (int)(rng() % 1024)};
+    Coord end = {(int)(rng() % 1024), (int)(rng() % 1024)};
+    if (!shared.isWall(start) && !shared.isWall(end)) queries.push_back({start, end});
+  }
+  std::cout << "Shared 1024x1024 map, 20% walls, " << queries.size() << " queries" << std::endl;
+  int counts[] = {1, 0};
+  for (int i=0; i<2; i++) {
+    BatchSolver pool(shared, counts[i]);
+    begin = std::chrono::steady_clock::now();
+    pool.solve(queries);
+    finish = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(finish - begin).count();
+    std::cout << "[Batch]  " << pool.workers.size() << " worker(s): " << seconds * 1000.0 << " ms, "
+              << (long)(queries.size() / seconds) << " queries/sec" << std::endl;
+  }
+
+  // One long query, shared by the threads of HDA*
+  std::cout << "One corner to corner query on the large map" << std::endl;
+  compare("[A*]    ", flat, {0, 0}, {2047, 2047});
+  for (int i=0; i<2; i++) {
+    HDAStar parallel(large, counts[i]);
+    begin = std::chrono::steady_clock::now();
+    std::vector<Coord> route = parallel.findPath({0, 0}, {2047, 2047});
+    finish = std::chrono::steady_clock::now();
+    std::cout << "[HDA*]   " << parallel.threads << " thread(s): " << parallel.expanded << " expansions, "
+              << route.size() << " cells, " << std::chrono::duration<double>(finish - begin).count() * 1000.0
+              << " ms" << std::endl;
+  }
+
+  // Routes between a few hot endpoints, with a wall toggled now and then
+  PathCache cache(shared);
+  std::vector<Coord> hot;
+  while (hot.size() < 8) {
+    Coord a = {(int)(rng() % 1024), (int)(rng() % 1024)};
+    if (!shared.isWall(a)) hot.push_back(a);
+  }
+  double hitTime = 0, missTime = 0;
+  for (int q=0; q<2000; q++) {
+    if (q % 100 == 99) {
+      Coord a = {(int)(rng() % 1024), (int)(rng() % 1024)};
+      shared.cell(a).status = shared.isWall(a) ? Board::EMPTY : Board::WALL;
+      cache.update(a);
+    }
+    int before = cache.hits;
+    begin = std::chrono::steady_clock::now();
+    cache.findPath(hot[rng() % 8], hot[rng() % 8]);
+    finish = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(finish - begin).count();
+    if (cache.hits > before) hitTime += seconds;
+    else missTime += seconds;
+  }
+  std::cout << "Hot routes on the shared map, 2000 queries, a wall toggled every 100" << std::endl;
+  std::cout << "[Cache]  " << cache.hits << " hits, " << hitTime * 1e6 / cache.hits << " us each" << std::endl;
+  std::cout << "[Cache]  " << cache.misses << " misses, " << missTime * 1e6 / cache.misses << " us each" << std::endl;
+
+  // END walled in, A* exhausts everything reachable before giving up
+  ComponentIndex components(shared);
+  for (int i=-20; i<=20; i++) {
+    Coord ring[4] = {{600 + i, 580}, {600 + i, 620}, {580, 600 + i}, {620, 600 + i}};
+    for (int j=0; j<4; j++) {
+      shared.cell(ring[j]).status = Board::WALL;
+      components.update(ring[j]);
+    }
+  }
+  AStar plain(shared);
+  Coord outside = hot[0];
+  shared.cell({600, 600}).status = Board::EMPTY;
+  components.update({600, 600});
+  std::cout << "Unreachable query on the shared map, END walled in" << std::endl;
+  compare("[A*]    ", plain, outside, {600, 600});
+  begin = std::chrono::steady_clock::now();
+  bool reachable = components.connected(outside, {600, 600});
+  finish = std::chrono::steady_clock::now();
+  std::cout << "[Index]  " << (reachable ? "reachable" : "unreachable") << " in "
+            << std::chrono::duration<double>(finish - begin).count() * 1e6 << " us, "
+            << components.count() << " components" << std::endl;
+
+  // Keeping the index current, one toggled cell at a time against a full labeling
+  begin = std::chrono::steady_clock::now();
+  for (int t=0; t<1000; t++) {
+    Coord a = {(int)(rng() % 1024), (int)(rng() % 1024)};
+    shared.cell(a).status = shared.isWall(a) ? Board::EMPTY : Board::WALL;
+    components.update(a);
+  }
+  finish = std::chrono::steady_clock::now();
+  std::cout << "[Index]  1000 toggles: " << std::chrono::duration<double>(finish - begin).count() * 1e6 / 1000
+            << " us each" << std::endl;
+  begin = std::chrono::steady_clock::now();
+  components.build();
+  finish = std::chrono::steady_clock::now();
+  std::cout << "[Index]  full labeling: " << std::chrono::duration<double>(finish - begin).count() * 1000.0
+            << " ms" << std::endl;
+
+  // Agents spread over a map, all heading to its center
+  Board crowd = makeBoard(512, 512, 11, 20);
+  Coord goal = {256, 256};
+  crowd.cell(goal).status = Board::EMPTY;
+  std::vector<Coord> agents;
+  while (agents.size() < 200) {
+    Coord a = {(int)(rng() % 512), (int)(rng() % 512)};
+    if (!crowd.isWall(a)) agents.push_back(a);
+  }
+  std::cout << "Crowd on a 512x512 map, 20% walls, " << agents.size() << " agents to one goal" << std::endl;
+  AStar each(crowd);
+  long moves = 0;
+  begin = std::chrono::steady_clock::now();
+  for (int i=0; i<(int)agents.size(); i++) {
+    moves += each.findPath(agents[i], goal).size();
+  }
+  finish = std::chrono::steady_clock::now();
+  std::cout << "[A*]     one search per agent: " << std::chrono::duration<double>(finish - begin).count() * 1000.0
+            << " ms, " << moves << " cells" << std::endl;
+  FlowField field(crowd);
+  moves = 0;
+  begin = std::chrono::steady_clock::now();
+  field.build(goal);
+  for (int i=0; i<(int)agents.size(); i++) {
+    for (Coord a = agents[i], b = field.next(a); a.x != b.x || a.y != b.y; a = b, b = field.next(a)) {
+      moves++;
+    }
+    moves++;
+  }
+  finish = std::chrono::steady_clock::now();
+  std::cout << "[Flow]   one field and every walk: " << std::chrono::duration<double>(finish - begin).count() * 1000.0
+            << " ms, " << moves << " cells" << std::endl;
+
+  // Walls toggled near the goal, only the cells routed through them are recomputed
+  long touched = 0;
+  begin = std::chrono::steady_clock::now();
+  for (int t=0; t<100; t++) {
+    Coord a = {256 + (int)(rng() % 64) - 32, 256 + (int)(rng() % 64) - 32};
+    if (a.x == goal.x && a.y == goal.y) continue;
+    crowd.cell(a).status = crowd.isWall(a) ? Board::EMPTY : Board::WALL;
+    field.update(a);
+    touched += field.expanded;
+  }
+  finish = std::chrono::steady_clock::now();
+  std::cout << "[Flow]   100 toggles: " << std::chrono::duration<double>(finish - begin).count() * 1e6 / 100
+            << " us, " << touched / 100 << " cells each" << std::endl;
+  begin = std::chrono::steady_clock::now();
+  field.build(goal);
+  finish = std::chrono::steady_clock::now();
+  std::cout << "[Flow]   full build: " << std::chrono::duration<double>(finish - begin).count() * 1e6
+            << " us, " << field.expanded << " cells" << std::endl;
+
+  // Fleets on a small warehouse-like map, every agent with its own start and END
+  Board fleet = makeBoard(64, 64, 5, 10);
+  int fleetSizes[] = {10, 30, 50};
+  std::cout << "Fleet on a 64x64 map, 10% walls, 10 s budget" << std::endl;
+  for (int f=0; f<3; f++) {
+    std::vector<CBS::Agent> agents;
+    std::vector<bool> taken(64*64*2, false);
+    while ((int)agents.size() < fleetSizes[f]) {
+      Coord start = {(int)(rng() % 64), (int)(rng() % 64)};
+      Coord end = {(int)(rng() % 64), (int)(rng() % 64)};
+      if (fleet.isWall(start) || fleet.isWall(end) || taken[fleet.index(start)] || taken[64*64 + fleet.index(end)]) continue;
+      if (findPath(fleet, start, end).empty()) continue;
+      taken[fleet.index(start)] = taken[64*64 + fleet.index(end)] = true;
+      agents.push_back({start, end});
+    }
+    CBS cbs(fleet);
+    begin = std::chrono::steady_clock::now();
+    bool solved = cbs.solve(agents, 10.0);
+    finish = std::chrono::steady_clock::now();
+    int total = 0;
+    for (int i=0; i<(int)cbs.paths.size(); i++) {
+      total += cbs.low.cost(cbs.paths[i]);
+    }
+    std::cout << "[CBS]    " << agents.size() << " agents: " << (solved ? "solved" : cbs.timedOut ? "timed out" : "no solution")
+              << " in " << std::chrono::duration<double>(finish - begin).count() * 1000.0 << " ms, cost " << total << ", "
+              << cbs.expanded << " tree nodes, " << cbs.lowExpanded << " low-level expansions" << std::endl;
+  }
+
+  // Online fleet, replanned a share at a time while it moves
+  Board depot = makeBoard(128, 128, 13, 10);
+  WHCAStar whca(depot, 16);
+  std::vector<bool> used(128*128*2, false);
+  while (whca.agents.size() < 200) {
+    Coord start = {(int)(rng() % 128), (int)(rng() % 128)};
+    Coord end = {(int)(rng() % 128), (int)(rng() % 128)};
+    if (depot.isWall(start) || depot.isWall(end) || used[depot.index(start)] || used[128*128 + depot.index(end)]) continue;
+    if (findPath(depot, start, end).empty()) continue;
+    used[depot.index(start)] = used[128*128 + depot.index(end)] = true;
+    whca.add(start, end);
+  }
+  double tickTotal = 0, tickWorst = 0;
+  int ticks = 0, replanTotal = 0, replanWorst = 0;
+  while (!whca.arrived() && ticks < 2000) {
+    begin = std::chrono::steady_clock::now();
+    whca.tick();
+    finish = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(finish - begin).count();
+    // The first tick plans every agent at once
+    if (ticks > 0) {
+      tickTotal += seconds;
+      tickWorst = std::max(tickWorst, seconds);
+      replanTotal += whca.replans;
+      replanWorst = std::max(replanWorst, whca.replans);
+    }
+    ticks++;
+  }
+  std::cout << "Fleet of " << whca.agents.size() << " on a 128x128 map, 10% walls, window of 16" << std::endl;
+  std::cout << "[WHCA*]  " << (whca.arrived() ? "arrived" : "still moving") << " after " << ticks << " ticks, "
+            << whca.collisions << " collisions" << std::endl;
+  std::cout << "[WHCA*]  per tick: " << tickTotal * 1000.0 / (ticks - 1) << " ms average, " << tickWorst * 1000.0
+            << " ms worst, " << (double)replanTotal / (ticks - 1) << " replans average, " << replanWorst << " worst" << std::endl;
+
+  // A path within 2 ms on a 512x512 map, improved while time allows, against
+  // the optimum and the time A* takes to find it
+  Board wide = makeBoard(512, 512, 17, 25);
+  ARAStar ara(wide);
+  std::cout << "Random 512x512 map, 25% walls, corner to corner, anytime" << std::endl;
+  begin = std::chrono::steady_clock::now();
+  ara.improved = [&](const std::vector<Coord>& path, double bound) {
+    double ms = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count() * 1000.0;
+    std::cout << "[ARA*]   weight " << ara.epsilon << ": length " << path.size() << ", bound " << bound
+              << ", after " << ms << " ms" << std::endl;
+  };
+  std::vector<Coord> anytime = ara.solve({0, 0}, {511, 511}, 0.002);
+  std::cout << "[ARA*]   2 ms budget: " << (ara.timedOut ? "timed out" : "optimal") << ", length " << anytime.size() << ", bound " << ara.bound << std::endl;
+  ara.improved = nullptr;
+  begin = std::chrono::steady_clock::now();
+  anytime = ara.solve({0, 0}, {511, 511}, 60.0);
+  finish = std::chrono::steady_clock::now();
+  std::cout << "[ARA*]   down to weight 1: length " << anytime.size() << ", "
+            << std::chrono::duration<double>(finish - begin).count() * 1000.0 << " ms" << std::endl;
+  AStar exact(wide);
+  compare("[A*]    ", exact, {0, 0}, {511, 511});
+  return 0;
+}
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include "arastar.hpp"
+
+// Membership of a cell in incons, next to IN_OPEN and IN_CLOSED
+#define IN_INCONS 4
+
+// Cells handled per step between two weights
+#define CHUNK 64
+
+// Constructor
+ARAStar::ARAStar(const Board& board, double weight, double decrement) : AStar(board), weight(weight), decrement(decrement) {
+  epsilon = weight;
+  bound = 0;
+  cost = 0;
+  phase = EXPANDING;
+  timedOut = false;
+}
+
+// Start with the first weight, forgetting the previous paths
+void ARAStar::init(Coord start, Coord end) {
+  epsilon = weight;
+  bound = 0;
+  cost = 0;
+  best.clear();
+  incons.clear();
+  closed.clear();
+  cells.clear();
+  phase = EXPANDING;
+  timedOut = false;
+  AStar::init(start, end);
+  Node& s = node(board.index(start));
+  s.f = key(s);
+  openSet.clear();
+  openSet.push(board.index(start), s.f, s.h);
+}
+
+// Expand one cell, or take the next few steps between two weights: drain the
+// open set, publish the path, reopen the closed cells, and push the cells left
+// with the keys of the next weight, CHUNK cells per call so that a deadline
+// is never overrun by more than a few calls
+AStar::State ARAStar::step() {
+  if (state != SEARCHING) return state;
+
+  if (phase == EXPANDING) {
+    Node& goal = node(board.index(end));
+    if (!openSet.empty() && goal.g > openSet.top().f) {
+      Coord cur = board.coord(openSet.pop());
+      node(board.index(cur)).set = IN_CLOSED;
+      closed.push_back(board.index(cur));
+      expanded++;
+      expand(cur);
+      return state;
+    }
+    if (goal.g == 2147483647) {
+      state = NO_PATH;
+      return state;
+    }
+    // Cells still open or inconsistent bound the cost of the path, and are
+    // searched again with the next weight
+    cells.swap(incons);
+    incons.clear();
+    lowest = goal.g;
+    for (int i=0; i<(int)cells.size(); i++) {
+      lowest = std::min(lowest, node(cells[i]).g + node(cells[i]).h);
+    }
+    phase = DRAINING;
+    return state;
+  }
+
+  if (phase == DRAINING) {
+    for (int k=0; k<CHUNK && !openSet.empty(); k++) {
+      int id = openSet.pop();
+      cells.push_back(id);
+      lowest = std::min(lowest, node(id).g + node(id).h);
+    }
+    if (!openSet.empty()) return state;
+    publish();
+    if (epsilon <= 1 || bound <= 1) {
+      state = FOUND;
+      return state;
+    }
+    // Weights above the bound already met cannot give a better guarantee
+    epsilon = std::max(1.0, std::min(epsilon, bound) - decrement);
+    phase = CLOSING;
+    return state;
+  }
+
+  if (phase == CLOSING) {
+    for (int k=0; k<CHUNK && !closed.empty(); k++) {
+      Node& a = node(closed.back());
+      if (a.set == IN_CLOSED) a.set = 0;
+      closed.pop_back();
+    }
+    if (closed.empty()) phase = REOPENING;
+    return state;
+  }
+
+  for (int k=0; k<CHUNK && !cells.empty(); k++) {
+    Node& a = node(cells.back());
+    a.set = IN_OPEN;
+    a.f = key(a);
+    openSet.push(cells.back(), a.f, a.h);
+    cells.pop_back();
+  }
+  if (cells.empty()) phase = EXPANDING;
+  return state;
+}
+
+// Best path found so far, even while the search goes on
+std::vector<Coord> ARAStar::path() {
+  return best;
+}
+
+// Search until the path is optimal or the seconds run out, checked every 16
+// steps, and return the best path found
+std::vector<Coord> ARAStar::solve(Coord start, Coord end, double seconds) {
+  auto deadline = std::chrono::steady_clock::now() +
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+  init(start, end);
+  for (int i=0; state == SEARCHING; i++) {
+    if ((i & 15) == 15 && std::chrono::steady_clock::now() > deadline) {
+      timedOut = true;
+      break;
+    }
+    step();
+  }
+  return best;
+}
+
+// Priority of a cell, its hScore inflated by the current weight
+int ARAStar::key(Node& a) {
+  return a.g + (int)(epsilon*a.h);
+}
+
+// Check left, right, top, and bottom neighbors, a move costs the terrain it enters
+void ARAStar::expand(Coord cur) {
+  if (cur.x > 0) relax(cur, {cur.x - 1, cur.y}, board.cell({cur.x - 1, cur.y}).cost);
+  if (cur.x < board.width - 1) relax(cur, {cur.x + 1, cur.y}, board.cell({cur.x + 1, cur.y}).cost);
+  if (cur.y > 0) relax(cur, {cur.x, cur.y - 1}, board.cell({cur.x, cur.y - 1}).cost);
+  if (cur.y < board.height - 1) relax(cur, {cur.x, cur.y + 1}, board.cell({cur.x, cur.y + 1}).cost);
+}
+
+// A cheaper way to b goes to the open set, or to incons if b was expanded
+// with the current weight already
+void ARAStar::relax(Coord cur, Coord b, int cost) {
+  if (board.isWall(b)) return;
+  int id = board.index(b);
+  Node& nb = node(id);
+  int g = node(board.index(cur)).g + cost;
+  if (g >= nb.g) return;
+
+  if (nb.h == 2147483647) nb.h = estimate(b);
+  nb.g = g;
+  nb.parent = cur;
+  nb.f = key(nb);
+  if (nb.set & IN_CLOSED) {
+    if (!(nb.set & IN_INCONS)) incons.push_back(id);
+    nb.set |= IN_INCONS;
+  } else if (nb.set & IN_OPEN) {
+    openSet.decrease(id, nb.f, nb.h);
+  } else {
+    nb.set = IN_OPEN;
+    openSet.push(id, nb.f, nb.h);
+    generated.push_back(id);
+  }
+}
+
+// Keep the path of the search that just ended if it is cheaper, and report
+// it with the tighter of the weight and its cost over lowest, the lowest
+// unweighted fScore among the cells left, which no path can beat
+// Parents may have improved since the END was reached, so the path can cost
+// less than the gScore of END, and another search can end on a dearer one
+void ARAStar::publish() {
+  std::vector<Coord> found = pathTo(end);
+  int c = 0;
+  for (int i=1; i<(int)found.size(); i++) {
+    c += board.cell(found[i]).cost;
+  }
+  if (best.empty() || c < cost) {
+    best = found;
+    cost = c;
+  }
+  double tighter = lowest > 0 ? std::min(epsilon, (double)cost / lowest) : 1.0;
+  if (bound == 0 || tighter < bound) {
+    bound = tighter;
+    if (improved) improved(best, bound);
+  }
+}
@@ -0,0 +1,51 @@
+#ifndef __ARASTAR_HPP__
+#define __ARASTAR_HPP__
+
+#include <chrono>
+#include <functional>
+#include <vector>
+#include "astar.hpp"
+
+// Anytime Repairing A*: a first path comes fast from a heuristic inflated by
+// weight, then the weight is lowered step by step down to 1, each search
+// reusing the costs found by the previous ones, as in
+// Likhachev, Gordon and Thrun, "ARA*: Anytime A* with Provable Bounds on
+// Sub-Optimality", NIPS 2003
+// A path found with weight w costs at most w times the optimum, and a tighter
+// bound is taken from the lowest unweighted fScore still open
+// Cells improved after they were expanded wait in incons for the next weight
+class ARAStar : public AStar {
+public:
+  // What step does next: expand, or move on to the next weight
+  typedef enum Phase {
+    EXPANDING, DRAINING, CLOSING, REOPENING
+  } Phase;
+
+  typedef std::function<void(const std::vector<Coord>& path, double bound)> Callback;
+
+  double weight; // First weight
+  double decrement;
+  double epsilon; // Weight of the current search
+  double bound;   // Suboptimality bound of the best path, 0 until there is one
+  std::vector<Coord> best;
+  int cost; // Of the best path
+  std::vector<int> incons, closed;
+  std::vector<int> cells; // Open and inconsistent cells, between two weights
+  int lowest; // Lowest unweighted fScore among them
+  Phase phase;
+  Callback improved; // Called with every better path or tighter bound
+  bool timedOut;
+
+  ARAStar(const Board& board, double weight = 3.0, double decrement = 0.1);
+  void init(Coord start, Coord end);
+  State step();
+  std::vector<Coord> path();
+  std::vector<Coord> solve(Coord start, Coord end, double seconds);
+
+  int key(Node& a);
+  void expand(Coord cur);
+  void relax(Coord cur, Coord b, int cost);
+  void publish();
+};
+
+#endif
@@ -0,0 +1,164 @@
+#include <algorithm>
+#include "astar.hpp"
+
+// Constructor, the search state is allocated once for every cell of the board
+AStar::AStar(const Board& board) : board(board), n(board.width*board.height), openSet(board.width*board.height) {
+  start = {-1, -1};
+  end = {-1, -1};
+  state = NO_PATH;
+  expanded = 0;
+  generation = 0;
+  reverse = false;
+  for (int i=0; i<(int)n.size(); i++) {
+    n[i].gen = 0;
+  }
+}
+
+// Start a new search from start to end
+void AStar::init(Coord start, Coord end) {
+  this->start = start;
+  this->end = end;
+
+  // A new generation makes every cell of the previous search stale in O(1)
+  // Only when the counter wraps around are the stamps cleared for real
+  if (++generation == 0) {
+    for (int i=0; i<(int)n.size(); i++) {
+      n[i].gen = 0;
+    }
+    generation = 1;
+  }
+  openSet.clear();
+  generated.clear();
+  expanded = 0;
+
+  // Initialize the open set
+  Node& s = node(board.index(start));
+  s.g = 0;
+  s.h = estimate(start);
+  s.f = s.g + s.h;
+  s.parent = {-1, -1};
+  s.set = IN_OPEN;
+  openSet.push(board.index(start), s.f, s.h);
+  generated.push_back(board.index(start));
+  state = SEARCHING;
+}
+
+// Expand the cell with the lowest fScore
+AStar::State AStar::step() {
+  if (state != SEARCHING) return state;
+
+  // If the open set is empty, there is no solution
+  if (openSet.empty()) {
+    state = NO_PATH;
+    return state;
+  }
+
+  // The current cell is the one with the lowest fScore
+  Coord cur = board.coord(openSet.pop());
+  node(board.index(cur)).set = IN_CLOSED;
+  expanded++;
+  expand(cur);
+
+  // Check if the END cell is in the closed set
+  if (node(board.index(end)).set & IN_CLOSED) {
+    state = FOUND;
+  }
+  return state;
+}
+
+// A cell was toggled or its terrain cost changed, which only matters to the
+// solvers that keep state from one search to the next
+void AStar::update(Coord) {
+}
+
+// Search state of a cell, a stale one is reset on first access
+AStar::Node& AStar::node(int id) {
+  Node& a = n[id];
+  if (a.gen != generation) {
+    // Assign values to INT_MAX
+    a.f = 2147483647;
+    a.g = 2147483647;
+    a.h = 2147483647;
+    a.set = 0;
+    a.gen = generation;
+  }
+  return a;
+}
+
+// Manhattan distance to the END cell, scaled by the cheapest terrain
+int AStar::estimate(Coord a) {
+  return board.heuristic(a, end) * board.minCost();
+}
+
+// Check left, right, top, and bottom neighbors, a move costs the terrain it enters
+void AStar::expand(Coord cur) {
+  int leaving = board.cell(cur).cost;
+  if (cur.x > 0) processNeighbor(cur, {cur.x - 1, cur.y}, reverse ? leaving : board.cell({cur.x - 1, cur.y}).cost);
+  if (cur.x < board.width - 1) processNeighbor(cur, {cur.x + 1, cur.y}, reverse ? leaving : board.cell({cur.x + 1, cur.y}).cost);
+  if (cur.y > 0) processNeighbor(cur, {cur.x, cur.y - 1}, reverse ? leaving : board.cell({cur.x, cur.y - 1}).cost);
+  if (cur.y < board.height - 1) processNeighbor(cur, {cur.x, cur.y + 1}, reverse ? leaving : board.cell({cur.x, cur.y + 1}).cost);
+}
+
+// Reach a neighbor from cur at the given cost
+void AStar::processNeighbor(Coord cur, Coord neighbor, int cost) {
+  int id = board.index(neighbor);
+  Node& nb = node(id);
+  if ((nb.set & IN_CLOSED) || board.isWall(neighbor)) return;
+
+  int tentative_gScore = node(board.index(cur)).g + cost;
+  int hScore = estimate(neighbor);
+  int fScore = tentative_gScore + hScore;
+
+  if (!(nb.set & IN_OPEN)) {
+    nb.set = IN_OPEN;
+    nb.g = tentative_gScore;
+    nb.h = hScore;
+    nb.f = fScore;
+    nb.parent = cur;
+    openSet.push(id, fScore, hScore);
+    generated.push_back(id);
+  } else if (fScore < nb.f) {
+    nb.g = tentative_gScore;
+    nb.h = hScore;
+    nb.f = fScore;
+    nb.parent = cur;
+    openSet.decrease(id, fScore, hScore);
+  }
+}
+
+// Path found by the last search from start to end, empty if there is none
+std::vector<Coord> AStar::path() {
+  if (state != FOUND) return std::vector<Coord>();
+  return pathTo(end);
+}
+
+// Path from start to a cell reached by the search, following the parents
+// A parent may lie several cells away on a straight or diagonal line, as with
+// jump points, so the cells in between are filled in
+std::vector<Coord> AStar::pathTo(Coord a) {
+  std::vector<Coord> result;
+  for (Coord cur = a; cur.x != -1; cur = n[board.index(cur)].parent) {
+    Coord parent = n[board.index(cur)].parent;
+    result.push_back(cur);
+    if (parent.x == -1) break;
+    int dx = (parent.x > cur.x) - (parent.x < cur.x);
+    int dy = (parent.y > cur.y) - (parent.y < cur.y);
+    for (Coord b = {cur.x + dx, cur.y + dy}; b.x != parent.x || b.y != parent.y; b = {b.x + dx, b.y + dy}) {
+      result.push_back(b);
+    }
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+// Run a whole search from start to end
+std::vector<Coord> AStar::findPath(Coord start, Coord end) {
+  init(start, end);
+  while (step() == SEARCHING);
+  return path();
+}
+
+std::vector<Coord> findPath(const Board& board, Coord start, Coord end) {
+  AStar search(board);
+  return search.findPath(start, end);
+}
@@ -0,0 +1,68 @@
+#ifndef __ASTAR_HPP__
+#define __ASTAR_HPP__
+
+#include <vector>
+#include "board.hpp"
+#include "openset.hpp"
+#include "bucketqueue.hpp"
+
+// Open set of the searches, an indexed binary heap unless built with
+// ASTAR_BUCKET_QUEUE, which selects buckets indexed by fScore instead
+#ifdef ASTAR_BUCKET_QUEUE
+typedef BucketQueue OpenList;
+#else
+typedef OpenSet OpenList;
+#endif
+
+// A* search over a board, runnable one expansion at a time or to completion
+// The board is only read, so one board can be shared by several searches
+// Variants such as JPS override how a cell is expanded and estimated
+class AStar {
+public:
+  // The state of a search
+  typedef enum State {
+    SEARCHING, FOUND, NO_PATH
+  } State;
+
+  // Membership of a cell in the open and closed sets
+  typedef enum SetFlag {
+    IN_OPEN = 1, IN_CLOSED = 2
+  } SetFlag;
+
+  // Search state of a cell, only valid if gen matches the current search
+  typedef struct Node {
+    int f, g, h;
+    unsigned char set;
+    Coord parent;
+    unsigned int gen;
+  } Node;
+
+  const Board& board;
+  std::vector<Node> n;
+  unsigned int generation;
+  OpenList openSet;
+  Coord start, end;
+  State state;
+  int expanded;
+  std::vector<int> generated; // Cells in the order they entered the open set
+  bool reverse; // The search runs from the end of the path, a move costs the cell it leaves
+
+  AStar(const Board& board);
+  virtual ~AStar() {}
+  virtual void init(Coord start, Coord end);
+  virtual State step();
+  virtual std::vector<Coord> path();
+  std::vector<Coord> pathTo(Coord a);
+  std::vector<Coord> findPath(Coord start, Coord end);
+  virtual void update(Coord a);
+
+  Node& node(int id);
+  virtual int estimate(Coord a);
+  virtual void expand(Coord cur);
+  void processNeighbor(Coord cur, Coord neighbor, int cost = 1);
+};
+
+// Shortest path from start to end, including both, empty if there is none
+std::vector<Coord> findPath(const Board& board, Coord start, Coord end);
+
+#endif
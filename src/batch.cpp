@@ -0,0 +1,74 @@
+#include "batch.hpp"
+
+// Constructor, one worker per hardware thread unless given
+BatchSolver::BatchSolver(const Board& board, int threads) : board(board) {
+  if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+  if (threads <= 0) threads = 1;
+  queries = NULL;
+  results = NULL;
+  next = 0;
+  busy = 0;
+  batch = 0;
+  stopping = false;
+
+  searches.reserve(threads);
+  for (int i=0; i<threads; i++) {
+    searches.push_back(AStar(board));
+  }
+  for (int i=0; i<threads; i++) {
+    workers.push_back(std::thread(&BatchSolver::run, this, i));
+  }
+}
+
+// Stop and join the workers
+BatchSolver::~BatchSolver() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (int i=0; i<(int)workers.size(); i++) {
+    workers[i].join();
+  }
+}
+
+// Solve every query, the paths are returned in the order of the queries
+// The board must not change until this returns
+std::vector<std::vector<Coord> > BatchSolver::solve(const std::vector<Query>& queries) {
+  std::vector<std::vector<Coord> > results(queries.size());
+  std::unique_lock<std::mutex> lock(mutex);
+  this->queries = &queries;
+  this->results = &results;
+  next = 0;
+  busy = (int)workers.size();
+  batch++;
+  wake.notify_all();
+  while (busy > 0) done.wait(lock);
+  this->queries = NULL;
+  this->results = NULL;
+  return results;
+}
+
+// Worker loop: wait for a batch, then take queries until none is left
+void BatchSolver::run(int worker) {
+  unsigned int seen = 0;
+  AStar& search = searches[worker];
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (!stopping && batch == seen) wake.wait(lock);
+      if (stopping) return;
+      seen = batch;
+    }
+
+    int count = (int)queries->size();
+    for (int i = next++; i < count; i = next++) {
+      (*results)[i] = search.findPath((*queries)[i].start, (*queries)[i].end);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--busy == 0) done.notify_one();
+    }
+  }
+}
@@ -0,0 +1,40 @@
+#ifndef __BATCH_HPP__
+#define __BATCH_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "astar.hpp"
+
+// Pool of worker threads solving independent queries on one board
+// The board is only read while a batch runs, and every worker owns its own
+// AStar search state, so the workers never share anything they write
+// Queries are handed out one at a time, which keeps the workers busy when
+// some paths are much longer than others
+class BatchSolver {
+public:
+  typedef struct Query {
+    Coord start, end;
+  } Query;
+
+  const Board& board;
+  std::vector<AStar> searches; // Search state of each worker
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable wake, done;
+  const std::vector<Query>* queries;
+  std::vector<std::vector<Coord> >* results;
+  std::atomic<int> next; // Next query to hand out
+  int busy;              // Workers still on the current batch
+  unsigned int batch;
+  bool stopping;
+
+  BatchSolver(const Board& board, int threads = 0);
+  ~BatchSolver();
+  std::vector<std::vector<Coord> > solve(const std::vector<Query>& queries);
+  void run(int worker);
+};
+
+#endif
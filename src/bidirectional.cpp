@@ -0,0 +1,84 @@
+#include <algorithm>
+#include "bidirectional.hpp"
+
+// Constructor
+BidirectionalAStar::BidirectionalAStar(const Board& board) : AStar(board), backward(board) {
+  backward.reverse = true;
+  best = 2147483647;
+  meet = {-1, -1};
+  shownBackward = 0;
+}
+
+// Start both searches, the backward one from end towards start
+void BidirectionalAStar::init(Coord start, Coord end) {
+  AStar::init(start, end);
+  backward.init(end, start);
+  best = 2147483647;
+  meet = {-1, -1};
+  shownBackward = 0;
+}
+
+// Expand one cell on the side with the smaller open set
+AStar::State BidirectionalAStar::step() {
+  if (state != SEARCHING) return state;
+
+  // An empty side has settled every cell it can reach
+  if (openSet.empty() || backward.openSet.empty()) {
+    state = best < 2147483647 ? FOUND : NO_PATH;
+    return state;
+  }
+
+  // With a consistent heuristic, no unexpanded cell of a side with its lowest
+  // fScore at or above best can lie on a shorter path
+  int lowest = std::max(openSet.top().f, backward.openSet.top().f);
+  if (lowest >= best) {
+    state = FOUND;
+    return state;
+  }
+
+  Coord cur;
+  if (openSet.size() <= backward.openSet.size()) {
+    cur = board.coord(openSet.top().id);
+    AStar::step();
+  } else {
+    cur = board.coord(backward.openSet.top().id);
+    backward.step();
+    expanded++;
+    for (; shownBackward < (int)backward.generated.size(); shownBackward++) {
+      generated.push_back(backward.generated[shownBackward]);
+    }
+  }
+  meetAround(cur);
+
+  // A side that closes its own goal has an optimal path by itself, and
+  // meetAround has recorded it since the goal has g = 0 on the other side
+  if (state == FOUND || backward.state == FOUND) state = FOUND;
+  return state;
+}
+
+// Record the cells around an expanded one that both searches have reached
+void BidirectionalAStar::meetAround(Coord cur) {
+  Coord cells[5] = {cur, {cur.x - 1, cur.y}, {cur.x + 1, cur.y}, {cur.x, cur.y - 1}, {cur.x, cur.y + 1}};
+  for (int i=0; i<5; i++) {
+    if (!board.inside(cells[i])) continue;
+    int id = board.index(cells[i]);
+    int forwardG = node(id).g;
+    int backwardG = backward.node(id).g;
+    if (forwardG == 2147483647 || backwardG == 2147483647) continue;
+    if (forwardG + backwardG < best) {
+      best = forwardG + backwardG;
+      meet = cells[i];
+    }
+  }
+}
+
+// Forward path to the meeting cell, then the backward path from it to end
+std::vector<Coord> BidirectionalAStar::path() {
+  std::vector<Coord> result;
+  if (state != FOUND) return result;
+  result = pathTo(meet);
+  std::vector<Coord> rest = backward.pathTo(meet);
+  std::reverse(rest.begin(), rest.end());
+  result.insert(result.end(), rest.begin() + 1, rest.end());
+  return result;
+}
@@ -0,0 +1,25 @@
+#ifndef __BIDIRECTIONAL_HPP__
+#define __BIDIRECTIONAL_HPP__
+
+#include "astar.hpp"
+
+// Bidirectional A*: the base search grows from start, a second one from end,
+// both with the Manhattan heuristic towards their own goal
+// The side with the smaller open set is expanded, and the search stops once
+// the lowest fScore of either open set is no better than the best meeting path
+class BidirectionalAStar : public AStar {
+public:
+  AStar backward;
+  int best; // Cost of the best path through a meeting cell so far
+  Coord meet;
+  int shownBackward; // Cells of the backward search already in generated
+
+  BidirectionalAStar(const Board& board);
+  void init(Coord start, Coord end);
+  State step();
+  std::vector<Coord> path();
+
+  void meetAround(Coord cur);
+};
+
+#endif
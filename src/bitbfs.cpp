@@ -0,0 +1,169 @@
+#include <algorithm>
+#include "bitbfs.hpp"
+
+// Constructor, the free cells are packed once and kept current by update
+BitBFS::BitBFS(const Board& board) : AStar(board) {
+  words = (board.width + 63) / 64;
+  free.assign((size_t)words*board.height, 0);
+  visited.assign(free.size(), 0);
+  frontier.assign(free.size(), 0);
+  ahead.assign(free.size(), 0);
+  half.assign(free.size(), 0);
+  zero.assign(words, 0);
+  spans.assign(board.height, {words, -1});
+  aheadSpans.assign(board.height, {words, -1});
+  lo = 0;
+  hi = -1;
+  layer = 0;
+  trace = true;
+  for (int y=0; y<board.height; y++) {
+    for (int x=0; x<board.width; x++) {
+      update({x, y});
+    }
+  }
+}
+
+// Start a new search from start to end
+void BitBFS::init(Coord start, Coord end) {
+  this->start = start;
+  this->end = end;
+  std::fill(visited.begin(), visited.end(), 0);
+  std::fill(half.begin(), half.end(), 0);
+  clear(frontier, spans);
+  generated.clear();
+  expanded = 1;
+  layer = 0;
+
+  int id = start.y*words + start.x/64;
+  visited[id] |= (uint64_t)1 << (start.x % 64);
+  frontier[id] |= (uint64_t)1 << (start.x % 64);
+  spans[start.y] = {start.x/64, start.x/64};
+  lo = hi = start.y;
+  generated.push_back(board.index(start));
+  state = start.x == end.x && start.y == end.y ? FOUND : SEARCHING;
+}
+
+// Grow the wavefront by one layer
+AStar::State BitBFS::step() {
+  if (state != SEARCHING) return state;
+  layer++;
+
+  int from = std::max(lo - 1, 0);
+  int to = std::min(hi + 1, board.height - 1);
+  int first = -1, last = -1;
+  uint64_t mark = layer & 2 ? ~(uint64_t)0 : 0;
+  for (int y=from; y<=to; y++) {
+    // Words the row can reach: its own frontier one word further, and the rows beside it
+    Span own = y >= lo && y <= hi ? spans[y] : Span{words, -1};
+    Span below = y - 1 >= lo ? spans[y - 1] : Span{words, -1};
+    Span above = y + 1 <= hi ? spans[y + 1] : Span{words, -1};
+    int left = std::max(std::min(std::min(own.left - 1, below.left), above.left), 0);
+    int right = std::min(std::max(std::max(own.right + 1, below.right), above.right), words - 1);
+
+    const uint64_t* row = &frontier[(size_t)y*words];
+    const uint64_t* down = y - 1 >= lo ? row - words : &zero[0];
+    const uint64_t* up = y + 1 <= hi ? row + words : &zero[0];
+    size_t base = (size_t)y*words;
+    Span reached = {words, -1};
+    uint64_t carry = left > 0 ? row[left - 1] >> 63 : 0; // Last bit of the word on the left
+    for (int w=left; w<=right; w++) {
+      // Move the frontier one cell right and left, carrying across words
+      uint64_t f = row[w];
+      uint64_t next = w < words - 1 ? row[w + 1] : 0;
+      uint64_t grow = (f << 1) | carry | (f >> 1) | (next << 63) | down[w] | up[w];
+      carry = f >> 63;
+      uint64_t bits = grow & free[base + w] & ~visited[base + w];
+      ahead[base + w] = bits;
+      visited[base + w] |= bits;
+      half[base + w] |= bits & mark;
+      if (bits) {
+        if (reached.left == words) reached.left = w;
+        reached.right = w;
+      }
+    }
+    aheadSpans[y] = reached;
+    if (reached.right != -1) {
+      if (first == -1) first = y;
+      last = y;
+    }
+  }
+
+  // The new frontier replaces the old one, cleared so that both stay zero outside their spans
+  clear(frontier, spans);
+  frontier.swap(ahead);
+  spans.swap(aheadSpans);
+  if (first == -1) {
+    lo = 0;
+    hi = -1;
+    state = NO_PATH;
+    count();
+    return state;
+  }
+  lo = first;
+  hi = last;
+
+  for (int y=lo; y<=hi && trace; y++) {
+    for (int w=spans[y].left; w<=spans[y].right; w++) {
+      uint64_t bits = frontier[(size_t)y*words + w];
+      for (; bits; bits &= bits - 1) {
+        generated.push_back(y*board.width + w*64 + __builtin_ctzll(bits));
+      }
+    }
+  }
+
+  if (test(visited, end)) {
+    state = FOUND;
+    count();
+  }
+  return state;
+}
+
+// Zero the rows of a frontier within their spans, and empty the spans
+void BitBFS::clear(std::vector<uint64_t>& bits, std::vector<Span>& rows) {
+  for (int y=lo; y<=hi; y++) {
+    for (int w=rows[y].left; w<=rows[y].right; w++) {
+      bits[(size_t)y*words + w] = 0;
+    }
+    rows[y] = {words, -1};
+  }
+}
+
+// Cells reached by the search, counted once it is over
+void BitBFS::count() {
+  expanded = 0;
+  for (size_t i=0; i<visited.size(); i++) {
+    expanded += __builtin_popcountll(visited[i]);
+  }
+}
+
+// Walk back from end, each step to the neighbor one layer closer to start
+std::vector<Coord> BitBFS::path() {
+  if (state != FOUND) return std::vector<Coord>();
+  std::vector<Coord> result(1, end);
+  Coord cur = end;
+  for (int k = layer; k > 0; k--) {
+    Coord around[4] = {{cur.x - 1, cur.y}, {cur.x + 1, cur.y}, {cur.x, cur.y - 1}, {cur.x, cur.y + 1}};
+    bool bit = ((k - 1) & 2) != 0;
+    for (int i=0; i<4; i++) {
+      if (board.inside(around[i]) && test(visited, around[i]) && test(half, around[i]) == bit) {
+        cur = around[i];
+        break;
+      }
+    }
+    result.push_back(cur);
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+// Copy the cell into the bitboard of free cells after it was toggled
+void BitBFS::update(Coord a) {
+  if (!board.inside(a)) return;
+  uint64_t bit = (uint64_t)1 << (a.x % 64);
+  if (board.isFree(a)) free[(size_t)a.y*words + a.x/64] |= bit;
+  else free[(size_t)a.y*words + a.x/64] &= ~bit;
+}
+
+bool BitBFS::test(const std::vector<uint64_t>& bits, Coord a) const {
+  return (bits[(size_t)a.y*words + a.x/64] >> (a.x % 64)) & 1;
+}
@@ -0,0 +1,44 @@
+#ifndef __BITBFS_HPP__
+#define __BITBFS_HPP__
+
+#include <cstdint>
+#include <vector>
+#include "astar.hpp"
+
+// Breadth-first search on bitboards for boards where every move costs the same
+// Each row of free cells is a run of 64-bit words, bit x%64 of word x/64 being
+// the cell x, and one step grows the whole wavefront a layer at once with
+// shifts, ORs and masks over the words of the rows it spans
+// The layer of a cell is never stored: on a 4-connected grid the visited
+// neighbors of a cell at layer k lie at k-1 or k+1, so the second bit of the
+// layer, kept in one more bitboard, tells them apart when walking back
+class BitBFS : public AStar {
+public:
+  // Words of a row holding its part of a frontier, left > right if none
+  typedef struct Span {
+    int left, right;
+  } Span;
+
+  int words; // 64-bit words per row
+  std::vector<uint64_t> free, visited;
+  std::vector<uint64_t> frontier, ahead; // Cells of the current and of the next layer
+  std::vector<uint64_t> half; // Second bit of the layer of each visited cell
+  std::vector<uint64_t> zero; // Row read above and below the frontier
+  std::vector<Span> spans, aheadSpans;
+  int lo, hi; // Rows spanned by the frontier
+  int layer;  // Layer of the frontier, the distance from start
+  bool trace; // Fill generated with every reached cell, for the viewer
+
+  BitBFS(const Board& board);
+  void init(Coord start, Coord end);
+  State step();
+  std::vector<Coord> path();
+  void update(Coord a);
+
+  void clear(std::vector<uint64_t>& bits, std::vector<Span>& rows);
+  void count();
+
+  bool test(const std::vector<uint64_t>& bits, Coord a) const;
+};
+
+#endif
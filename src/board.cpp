@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include "board.hpp"
+
+// Constructor, the cells are allocated once for width*height
+Board::Board(int width, int height) : width(width), height(height), c(width*height), costCount(256, 0) {
+  // Initialize cells
+  for (int i=0; i<width*height; i++) {
+    c[i].status = EMPTY;
+    c[i].cost = 1;
+  }
+  costCount[1] = width*height;
+  lowestCost = 1;
+
+  // Initialize start and end
+  start = {-1, -1};
+  end = {-1, -1};
+
+  // Initialize booleans
+  progress = PREPARING;
+}
+
+// Check if a coordinate lies on the board
+bool Board::inside(Coord a) const {
+  return a.x >= 0 && a.y >= 0 && a.x < width && a.y < height;
+}
+
+bool Board::isWall(Coord a) const {
+  return c[index(a)].status == WALL;
+}
+
+// Check if a coordinate lies on the board and is not a wall
+bool Board::isFree(Coord a) const {
+  return inside(a) && c[index(a)].status != WALL;
+}
+
+// Index of a cell in the row-major storage
+int Board::index(Coord a) const {
+  return a.y*width + a.x;
+}
+
+// Coordinate of an index in the row-major storage
+Coord Board::coord(int id) const {
+  return {id % width, id / width};
+}
+
+// Cell at a coordinate
+Board::Cell& Board::cell(Coord a) {
+  return c[index(a)];
+}
+
+const Board::Cell& Board::cell(Coord a) const {
+  return c[index(a)];
+}
+
+// Manhattan distance between two coordinates
+int Board::heuristic(Coord a, Coord b) const {
+  return abs(a.x-b.x) + abs(a.y-b.y);
+}
+
+// Octile distance between two coordinates, in STRAIGHT_COST/DIAGONAL_COST units
+int Board::octile(Coord a, Coord b) const {
+  int dx = abs(a.x-b.x);
+  int dy = abs(a.y-b.y);
+  int diagonal = dx < dy ? dx : dy;
+  return DIAGONAL_COST*diagonal + STRAIGHT_COST*(dx + dy - 2*diagonal);
+}
+
+// Change the terrain cost of a cell, keeping track of the lowest cost
+void Board::setCost(Coord a, int cost) {
+  if (cost < 1) cost = 1;
+  if (cost > 255) cost = 255;
+  costCount[c[index(a)].cost]--;
+  costCount[cost]++;
+  c[index(a)].cost = (unsigned char)cost;
+  if (cost < lowestCost) lowestCost = cost;
+  while (costCount[lowestCost] == 0) lowestCost++;
+}
+
+// Lowest terrain cost on the board, which keeps the scaled heuristics admissible
+int Board::minCost() const {
+  return lowestCost;
+}
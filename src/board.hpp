@@ -0,0 +1,54 @@
+#ifndef __BOARD_HPP__
+#define __BOARD_HPP__
+
+#include <vector>
+
+// Integer move costs for 8-connected movement, a diagonal is about sqrt(2) straight moves
+#define STRAIGHT_COST 10
+#define DIAGONAL_COST 14
+
+typedef struct Coord {
+  int x, y;
+} Coord;
+
+// Grid of cells shared by the solvers, free of any rendering dependency
+class Board {
+public:
+  // The status of a cell
+  typedef enum Status {
+    EMPTY, WALL, CHECKED, START, END, PATH
+  } Status;
+
+  // The progress of the A* algorithm
+  typedef enum Progress {
+    PREPARING, INITIALIZE, SOLVING, POST_SOLVE, FINISHED
+  } Progress;
+
+  // A move into a cell costs its terrain cost, from 1 (road) to 255
+  typedef struct Cell {
+    Status status;
+    unsigned char cost;
+  } Cell;
+
+  int width, height;
+  std::vector<Cell> c;
+  std::vector<int> costCount; // Cells of each terrain cost, set through setCost
+  int lowestCost;
+  Coord start, end;
+  Progress progress;
+
+  Board(int width, int height);
+  bool inside(Coord a) const;
+  bool isWall(Coord a) const;
+  bool isFree(Coord a) const;
+  int index(Coord a) const;
+  Coord coord(int id) const;
+  Cell& cell(Coord a);
+  const Cell& cell(Coord a) const;
+  int heuristic(Coord a, Coord b) const;
+  int octile(Coord a, Coord b) const;
+  void setCost(Coord a, int cost);
+  int minCost() const;
+};
+
+#endif
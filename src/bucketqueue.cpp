@@ -0,0 +1,78 @@
+#include "bucketqueue.hpp"
+
+// Constructor
+BucketQueue::BucketQueue(int capacity) {
+  bucket.assign(capacity, 0);
+  pos.assign(capacity, 0);
+  low = 0;
+  high = -1;
+  count = 0;
+}
+
+bool BucketQueue::empty() {
+  return count == 0;
+}
+
+int BucketQueue::size() {
+  return count;
+}
+
+// A position is only trusted if the bucket entry there points back to the cell
+bool BucketQueue::contains(int id) {
+  int b = bucket[id];
+  return b < (int)buckets.size() && pos[id] < (int)buckets[b].size() && buckets[b][pos[id]].id == id;
+}
+
+// Cell with the lowest fScore, the last one pushed among equals
+const BucketQueue::Node& BucketQueue::top() {
+  while (buckets[low].empty()) low++;
+  return buckets[low].back();
+}
+
+void BucketQueue::push(int id, int f, int h) {
+  if (f >= (int)buckets.size()) buckets.resize(f + 1);
+  buckets[f].push_back({f, h, id});
+  bucket[id] = f;
+  pos[id] = (int)buckets[f].size() - 1;
+  if (count == 0 || f < low) low = f;
+  if (f > high) high = f;
+  count++;
+}
+
+int BucketQueue::pop() {
+  int id = top().id;
+  buckets[low].pop_back();
+  count--;
+  return id;
+}
+
+// Move a cell to the bucket of its new fScore
+void BucketQueue::decrease(int id, int f, int h) {
+  remove(id);
+  push(id, f, h);
+}
+
+void BucketQueue::update(int id, int f, int h) {
+  remove(id);
+  push(id, f, h);
+}
+
+// Take a cell out of its bucket, the last cell of the bucket fills the hole
+void BucketQueue::remove(int id) {
+  std::vector<Node>& b = buckets[bucket[id]];
+  int i = pos[id];
+  b[i] = b.back();
+  pos[b[i].id] = i;
+  b.pop_back();
+  count--;
+}
+
+// Empty the buckets that were used, stale positions are rejected by contains
+void BucketQueue::clear() {
+  for (int f=low; f<=high; f++) {
+    buckets[f].clear();
+  }
+  low = 0;
+  high = -1;
+  count = 0;
+}
@@ -0,0 +1,34 @@
+#ifndef __BUCKETQUEUE_HPP__
+#define __BUCKETQUEUE_HPP__
+
+#include <vector>
+#include "openset.hpp"
+
+// Open set with one bucket per integer fScore, a drop-in for OpenSet
+// Push and decrease are O(1), and pop only scans up from the lowest bucket,
+// which moves by a few steps at a time on grids with small integer costs
+// Ties are broken last in, first out, the hScore is kept but not compared
+class BucketQueue {
+public:
+  typedef OpenSet::Node Node;
+
+  std::vector<std::vector<Node> > buckets; // Cells by fScore
+  std::vector<int> bucket, pos; // Bucket and position of each cell, stale for absent cells
+  int low;  // No cell is in a bucket below low
+  int high; // No cell is in a bucket above high
+  int count;
+
+  BucketQueue(int capacity);
+  bool empty();
+  int size();
+  bool contains(int id);
+  const Node& top();
+  void push(int id, int f, int h);
+  int pop();
+  void decrease(int id, int f, int h);
+  void update(int id, int f, int h);
+  void remove(int id);
+  void clear();
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include "cbs.hpp"
+
+// Constructor
+CBS::CBS(const Board& board) : board(board), low(board), table(board), open(0) {
+  expanded = 0;
+  lowExpanded = 0;
+  timedOut = false;
+  here.assign(board.width*board.height, 0);
+  before.assign(board.width*board.height, 0);
+  hereStamp.assign(board.width*board.height, 0);
+  beforeStamp.assign(board.width*board.height, 0);
+  stamp = 0;
+}
+
+// Plan every agent within the given seconds, false if there is no solution
+// or the time ran out first, which timedOut tells apart
+bool CBS::solve(const std::vector<Agent>& agents, double seconds) {
+  auto deadline = std::chrono::steady_clock::now() +
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+  low.deadline = deadline;
+  this->agents = agents;
+  tree.clear();
+  open.clear();
+  paths.clear();
+  expanded = 0;
+  lowExpanded = 0;
+  timedOut = false;
+
+  toGoal.resize(agents.size());
+  for (int i=0; i<(int)agents.size(); i++) {
+    low.distances(agents[i].end, toGoal[i]);
+  }
+
+  // Root: every agent on its own, with no constraint
+  TreeNode root;
+  root.parent = -1;
+  root.constraint.agent = -1;
+  root.cost = root.conflicts = 0;
+  root.paths.resize(agents.size());
+  tree.push_back(root);
+  for (int i=0; i<(int)agents.size(); i++) {
+    if (!plan(0, i)) {
+      timedOut = low.timedOut;
+      return false;
+    }
+  }
+  Conflict conflict;
+  tree[0].cost = 0;
+  for (int i=0; i<(int)agents.size(); i++) {
+    tree[0].cost += low.cost(tree[0].paths[i]);
+  }
+  tree[0].conflicts = conflicts(tree[0].paths, conflict);
+  open.reserve(1);
+  open.push(0, tree[0].cost, tree[0].conflicts);
+
+  while (!open.empty()) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      timedOut = true;
+      return false;
+    }
+    int id = open.pop();
+    expanded++;
+    if (tree[id].conflicts == 0) {
+      paths = tree[id].paths;
+      return true;
+    }
+
+    // Forbid the first conflict to one agent, then to the other
+    conflicts(tree[id].paths, conflict);
+    for (int side=0; side<2; side++) {
+      TreeNode child;
+      child.parent = id;
+      if (conflict.b.x == -1) {
+        child.constraint = {side ? conflict.second : conflict.first, conflict.a, {-1, -1}, conflict.t};
+      } else if (side == 0) {
+        child.constraint = {conflict.first, conflict.a, conflict.b, conflict.t};
+      } else {
+        child.constraint = {conflict.second, conflict.b, conflict.a, conflict.t};
+      }
+      child.paths = tree[id].paths;
+      tree.push_back(child);
+      int index = (int)tree.size() - 1;
+      int agent = child.constraint.agent;
+      if (!plan(index, agent)) {
+        if (low.timedOut) {
+          timedOut = true;
+          return false;
+        }
+        tree.pop_back();
+        continue;
+      }
+
+      Conflict next;
+      TreeNode& node = tree[index];
+      node.cost = tree[id].cost - low.cost(tree[id].paths[agent]) + low.cost(node.paths[agent]);
+      node.conflicts = conflicts(node.paths, next);
+      open.reserve(index + 1);
+      open.push(index, node.cost, node.conflicts);
+    }
+  }
+  return false;
+}
+
+// Plan one agent of a tree node under the constraints on its way from the root
+bool CBS::plan(int index, int agent) {
+  table.clear();
+  for (int i = index; i != -1; i = tree[i].parent) {
+    const Constraint& c = tree[i].constraint;
+    if (c.agent != agent) continue;
+    if (c.b.x == -1) table.addVertex(c.a, c.t);
+    else table.addEdge(c.a, c.b, c.t);
+  }
+  tree[index].paths[agent] = low.findPath(agents[agent].start, agents[agent].end, toGoal[agent], table);
+  lowExpanded += low.expanded;
+  return !tree[index].paths[agent].empty();
+}
+
+// Number of conflicts between the paths, the earliest one in first
+// Each time step marks the cells taken, and a move is a swap if the agent on
+// its target cell one step before is now on its source cell
+int CBS::conflicts(const std::vector<std::vector<Coord> >& paths, Conflict& first) {
+  int longest = 0;
+  for (int i=0; i<(int)paths.size(); i++) {
+    longest = std::max(longest, (int)paths[i].size());
+  }
+
+  int count = 0;
+  first.first = -1;
+  for (int t=0; t<longest; t++) {
+    here.swap(before);
+    hereStamp.swap(beforeStamp);
+    if (++stamp == 0) {
+      std::fill(hereStamp.begin(), hereStamp.end(), 0);
+      std::fill(beforeStamp.begin(), beforeStamp.end(), 0);
+      stamp = 2;
+    }
+    for (int i=0; i<(int)paths.size(); i++) {
+      Coord a = at(paths[i], t);
+      int id = board.index(a);
+      if (hereStamp[id] == stamp) {
+        count++;
+        if (first.first == -1) first = {here[id], i, a, {-1, -1}, t};
+      } else {
+        hereStamp[id] = stamp;
+        here[id] = i;
+      }
+      if (t == 0) continue;
+
+      Coord p = at(paths[i], t - 1);
+      if ((p.x == a.x && p.y == a.y) || beforeStamp[id] != stamp - 1) continue;
+      int j = before[id];
+      Coord q = at(paths[j], t);
+      if (j == i || q.x != p.x || q.y != p.y) continue;
+      if (j < i) count++;
+      if (first.first == -1) first = {i, j, p, a, t};
+    }
+  }
+  return count;
+}
+
+// Cell of a path at time t, the agent staying on its last cell
+Coord CBS::at(const std::vector<Coord>& path, int t) {
+  return t < (int)path.size() ? path[t] : path.back();
+}
@@ -0,0 +1,65 @@
+#ifndef __CBS_HPP__
+#define __CBS_HPP__
+
+#include <vector>
+#include "spacetime.hpp"
+
+// Conflict-Based Search: optimal paths for several agents that never share a
+// cell at the same time step nor swap places
+// Each node of the constraint tree holds one path per agent, planned by the
+// space-time A* under the constraints on the way from the root. The node of
+// lowest total cost is expanded, its first conflict found, and two children
+// each forbid it to one of the two agents, which alone is planned again
+// An agent stays on its END once it arrives, and blocks it for the others
+class CBS {
+public:
+  typedef struct Agent {
+    Coord start, end;
+  } Agent;
+
+  // Agent may not be on a at time t, or with b set, move from a to b arriving at t
+  typedef struct Constraint {
+    int agent;
+    Coord a, b;
+    int t;
+  } Constraint;
+
+  // Two agents on a at time t, or with b set, swapping a and b arriving at t
+  typedef struct Conflict {
+    int first, second;
+    Coord a, b;
+    int t;
+  } Conflict;
+
+  typedef struct TreeNode {
+    int parent;
+    Constraint constraint; // Added by this node, unused at the root
+    std::vector<std::vector<Coord> > paths;
+    int cost, conflicts;
+  } TreeNode;
+
+  const Board& board;
+  SpaceTimeAStar low;
+  ConstraintTable table;
+  std::vector<Agent> agents;
+  std::vector<std::vector<int> > toGoal; // Heuristic of each agent
+  std::vector<TreeNode> tree;
+  OpenSet open; // Ordered by cost, then by conflicts, over the tree
+  std::vector<std::vector<Coord> > paths; // Solution of the last solve
+  int expanded;     // Tree nodes expanded
+  long lowExpanded; // States expanded by the space-time A*
+  bool timedOut;
+
+  // Cells occupied at the current and the previous time step, while looking for conflicts
+  std::vector<int> here, before;
+  std::vector<unsigned int> hereStamp, beforeStamp;
+  unsigned int stamp;
+
+  CBS(const Board& board);
+  bool solve(const std::vector<Agent>& agents, double seconds);
+  bool plan(int index, int agent);
+  int conflicts(const std::vector<std::vector<Coord> >& paths, Conflict& first);
+  static Coord at(const std::vector<Coord>& path, int t);
+};
+
+#endif
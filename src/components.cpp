@@ -0,0 +1,208 @@
+#include <deque>
+#include "components.hpp"
+
+// Label of the free cells not reached yet while building
+#define UNLABELED -2
+
+// Constructor, the components are labeled right away
+ComponentIndex::ComponentIndex(const Board& board) : board(board) {
+  build();
+}
+
+// Label every component from scratch with a flood fill
+void ComponentIndex::build() {
+  int cells = board.width*board.height;
+  label.assign(cells, -1);
+  size.clear();
+  unused.clear();
+  seen.assign(cells, 0);
+  owner.assign(cells, 0);
+  gen = 0;
+  for (int id=0; id<cells; id++) {
+    if (board.isFree(board.coord(id))) label[id] = UNLABELED;
+  }
+  std::vector<int> cellsOf;
+  for (int id=0; id<cells; id++) {
+    if (label[id] != UNLABELED) continue;
+    cellsOf.assign(1, id);
+    relabel(cellsOf, UNLABELED, newLabel());
+  }
+}
+
+// Bring the index up to date after the cell was toggled between wall and free
+void ComponentIndex::update(Coord a) {
+  if (!board.inside(a)) return;
+  int id = board.index(a);
+  if (board.isFree(a) && label[id] == -1) join(a);
+  else if (!board.isFree(a) && label[id] != -1) split(a);
+}
+
+// Whether a path exists between two cells, in O(1)
+bool ComponentIndex::connected(Coord a, Coord b) const {
+  if (!board.inside(a) || !board.inside(b)) return false;
+  int la = label[board.index(a)];
+  return la != -1 && la == label[board.index(b)];
+}
+
+// Number of components
+int ComponentIndex::count() const {
+  return (int)(size.size() - unused.size());
+}
+
+int ComponentIndex::newLabel() {
+  if (!unused.empty()) {
+    int l = unused.back();
+    unused.pop_back();
+    return l;
+  }
+  size.push_back(0);
+  return (int)size.size() - 1;
+}
+
+// Flood fill the cells labeled from, starting at the given cells, and label them to
+void ComponentIndex::relabel(std::vector<int>& cells, int from, int to) {
+  std::deque<int> queue;
+  for (int i=0; i<(int)cells.size(); i++) {
+    if (label[cells[i]] != from) continue;
+    label[cells[i]] = to;
+    queue.push_back(cells[i]);
+  }
+  while (!queue.empty()) {
+    int id = queue.front();
+    queue.pop_front();
+    if (from >= 0) size[from]--;
+    size[to]++;
+    Coord cur = board.coord(id);
+    Coord next[4] = {{cur.x - 1, cur.y}, {cur.x + 1, cur.y}, {cur.x, cur.y - 1}, {cur.x, cur.y + 1}};
+    for (int i=0; i<4; i++) {
+      if (!board.inside(next[i])) continue;
+      int nb = board.index(next[i]);
+      if (label[nb] != from) continue;
+      label[nb] = to;
+      queue.push_back(nb);
+    }
+  }
+}
+
+// A freed cell joins the largest neighboring component, the others are merged into it
+void ComponentIndex::join(Coord a) {
+  Coord next[4] = {{a.x - 1, a.y}, {a.x + 1, a.y}, {a.x, a.y - 1}, {a.x, a.y + 1}};
+  int best = -1;
+  for (int i=0; i<4; i++) {
+    if (!board.inside(next[i])) continue;
+    int l = label[board.index(next[i])];
+    if (l != -1 && (best == -1 || size[l] > size[best])) best = l;
+  }
+  if (best == -1) best = newLabel();
+
+  for (int i=0; i<4; i++) {
+    if (!board.inside(next[i])) continue;
+    int l = label[board.index(next[i])];
+    if (l == -1 || l == best) continue;
+    std::vector<int> cells(1, board.index(next[i]));
+    relabel(cells, l, best);
+    unused.push_back(l);
+  }
+  label[board.index(a)] = best;
+  size[best]++;
+}
+
+// A new wall may cut its component in up to 4 pieces
+void ComponentIndex::split(Coord a) {
+  int id = board.index(a);
+  int l = label[id];
+  label[id] = -1;
+  if (--size[l] == 0) {
+    unused.push_back(l);
+    return;
+  }
+
+  // One search per free neighbor
+  Coord next[4] = {{a.x - 1, a.y}, {a.x + 1, a.y}, {a.x, a.y - 1}, {a.x, a.y + 1}};
+  std::vector<int> queue[4];
+  int head[4] = {0, 0, 0, 0};
+  int parent[4] = {0, 1, 2, 3}; // Searches that met, merged like a union-find
+  int k = 0;
+  if (++gen == 0) {
+    seen.assign(seen.size(), 0);
+    gen = 1;
+  }
+  for (int i=0; i<4; i++) {
+    if (!board.inside(next[i]) || label[board.index(next[i])] == -1) continue;
+    int nb = board.index(next[i]);
+    seen[nb] = gen;
+    owner[nb] = (unsigned char)k;
+    queue[k++].push_back(nb);
+  }
+  if (k < 2) return;
+
+  while (true) {
+    // Stop once at most one piece may still reach further
+    int open = 0;
+    for (int i=0; i<k; i++) {
+      if (parent[i] != i) continue;
+      for (int j=0; j<k; j++) {
+        int r = j;
+        while (parent[r] != r) r = parent[r];
+        if (r == i && head[j] < (int)queue[j].size()) {
+          open++;
+          break;
+        }
+      }
+    }
+    if (open <= 1) break;
+
+    // Advance every search by one cell
+    for (int i=0; i<k; i++) {
+      if (head[i] >= (int)queue[i].size()) continue;
+      Coord cur = board.coord(queue[i][head[i]++]);
+      Coord around[4] = {{cur.x - 1, cur.y}, {cur.x + 1, cur.y}, {cur.x, cur.y - 1}, {cur.x, cur.y + 1}};
+      for (int j=0; j<4; j++) {
+        if (!board.inside(around[j])) continue;
+        int nb = board.index(around[j]);
+        if (label[nb] != l) continue;
+        if (seen[nb] == gen) {
+          int ri = i, rj = owner[nb];
+          while (parent[ri] != ri) ri = parent[ri];
+          while (parent[rj] != rj) rj = parent[rj];
+          parent[ri] = rj;
+          continue;
+        }
+        seen[nb] = gen;
+        owner[nb] = (unsigned char)i;
+        queue[i].push_back(nb);
+      }
+    }
+  }
+
+  // The piece still open, or else the largest one, keeps the label
+  int cellsOf[4] = {0, 0, 0, 0};
+  bool open[4] = {false, false, false, false};
+  for (int i=0; i<k; i++) {
+    int r = i;
+    while (parent[r] != r) r = parent[r];
+    cellsOf[r] += (int)queue[i].size();
+    if (head[i] < (int)queue[i].size()) open[r] = true;
+  }
+  int keep = -1;
+  for (int i=0; i<k; i++) {
+    if (parent[i] != i) continue;
+    if (keep == -1 || open[i] > open[keep] || (open[i] == open[keep] && cellsOf[i] > cellsOf[keep])) keep = i;
+  }
+
+  // Every other piece was explored completely and gets a new label
+  for (int r=0; r<k; r++) {
+    if (parent[r] != r || r == keep) continue;
+    int fresh = newLabel();
+    for (int i=0; i<k; i++) {
+      int root = i;
+      while (parent[root] != root) root = parent[root];
+      if (root != r) continue;
+      for (int j=0; j<(int)queue[i].size(); j++) {
+        label[queue[i][j]] = fresh;
+      }
+      size[fresh] += (int)queue[i].size();
+      size[l] -= (int)queue[i].size();
+    }
+  }
+}
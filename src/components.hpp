@@ -0,0 +1,37 @@
+#ifndef __COMPONENTS_HPP__
+#define __COMPONENTS_HPP__
+
+#include <vector>
+#include "board.hpp"
+
+// Connected components of the non-WALL cells, 4-connected, kept up to date
+// cell by cell so that an unreachable END is known without any search
+// A freed cell merges its neighbors' components, relabeling the smaller ones
+// A new wall may split its component: searches from its free neighbors run
+// in lockstep and stop once a single piece is left unexplored, so only the
+// smaller pieces are visited and relabeled
+class ComponentIndex {
+public:
+  const Board& board;
+  std::vector<int> label; // Component of each cell, -1 for a wall
+  std::vector<int> size;  // Cells in each component, 0 if the label is unused
+  std::vector<int> unused; // Labels free for reuse
+
+  // Lockstep search state, valid if seen matches gen
+  std::vector<unsigned int> seen;
+  std::vector<unsigned char> owner;
+  unsigned int gen;
+
+  ComponentIndex(const Board& board);
+  void build();
+  void update(Coord a);
+  bool connected(Coord a, Coord b) const;
+  int count() const;
+
+  int newLabel();
+  void relabel(std::vector<int>& cells, int from, int to);
+  void join(Coord a);
+  void split(Coord a);
+};
+
+#endif
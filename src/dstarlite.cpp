@@ -0,0 +1,178 @@
+#include "dstarlite.hpp"
+
+// Constructor
+DStarLite::DStarLite(const Board& board) : AStar(board), v(board.width*board.height), queue(board.width*board.height) {
+  km = 0;
+  last = {-1, -1};
+  planned = false;
+  for (int i=0; i<(int)v.size(); i++) {
+    v[i].gen = 0;
+  }
+}
+
+// Plan from start to end, reusing the previous plan if end did not move
+void DStarLite::init(Coord start, Coord end) {
+  generated.clear();
+  expanded = 0;
+  state = SEARCHING;
+  if (planned && end.x == this->end.x && end.y == this->end.y) {
+    // Keys computed for the old start stay valid lower bounds once km grows
+    km += board.heuristic(last, start);
+    last = start;
+    this->start = start;
+    return;
+  }
+
+  this->start = start;
+  this->end = end;
+  if (++generation == 0) {
+    for (int i=0; i<(int)v.size(); i++) {
+      v[i].gen = 0;
+    }
+    generation = 1;
+  }
+  queue.clear();
+  km = 0;
+  last = start;
+  planned = true;
+
+  // The search starts from the END cell
+  vertex(board.index(end)).rhs = 0;
+  queue.push(board.index(end), estimate(end), 0);
+  generated.push_back(board.index(end));
+}
+
+// Process the cell with the lowest key, until the start cell is consistent
+AStar::State DStarLite::step() {
+  if (state != SEARCHING) return state;
+
+  int k1, k2;
+  key(start, k1, k2);
+  Vertex& s = vertex(board.index(start));
+  bool before = !queue.empty() && (queue.top().f < k1 || (queue.top().f == k1 && queue.top().h < k2));
+  if (!before && s.g == s.rhs) {
+    state = s.g < 2147483647 ? FOUND : NO_PATH;
+    return state;
+  }
+
+  int id = queue.top().id;
+  Coord u = board.coord(id);
+  key(u, k1, k2);
+
+  // The key was computed for an older start cell, queue it again
+  if (queue.top().f < k1 || (queue.top().f == k1 && queue.top().h < k2)) {
+    queue.update(id, k1, k2);
+    return state;
+  }
+
+  expanded++;
+  Vertex& x = vertex(id);
+  if (x.g > x.rhs) {
+    // Overconsistent: the cell got closer to END
+    x.g = x.rhs;
+    queue.remove(id);
+  } else {
+    // Underconsistent: the cell got farther, recompute it and its neighbors
+    x.g = 2147483647;
+    updateVertex(u);
+  }
+  updateVertex({u.x - 1, u.y});
+  updateVertex({u.x + 1, u.y});
+  updateVertex({u.x, u.y - 1});
+  updateVertex({u.x, u.y + 1});
+  return state;
+}
+
+// Follow the lowest g from the start cell down to END
+std::vector<Coord> DStarLite::path() {
+  std::vector<Coord> result;
+  if (state != FOUND) return result;
+
+  Coord cur = start;
+  result.push_back(cur);
+  while ((cur.x != end.x || cur.y != end.y) && (int)result.size() <= (int)v.size()) {
+    Coord next[4] = {{cur.x - 1, cur.y}, {cur.x + 1, cur.y}, {cur.x, cur.y - 1}, {cur.x, cur.y + 1}};
+    Coord best = cur;
+    int bestG = 2147483647;
+    for (int i=0; i<4; i++) {
+      if (!board.isFree(next[i])) continue;
+      int g = vertex(board.index(next[i])).g;
+      if (g < bestG) {
+        bestG = g;
+        best = next[i];
+      }
+    }
+    if (bestG == 2147483647) return std::vector<Coord>();
+    cur = best;
+    result.push_back(cur);
+  }
+  return result;
+}
+
+// A toggled cell changes the edges to its neighbors, so all of them are
+// checked again, the repair itself runs in the following steps
+void DStarLite::update(Coord a) {
+  if (!planned) return;
+  updateVertex(a);
+  updateVertex({a.x - 1, a.y});
+  updateVertex({a.x + 1, a.y});
+  updateVertex({a.x, a.y - 1});
+  updateVertex({a.x, a.y + 1});
+}
+
+// Search state of a cell, a stale one is reset on first access
+DStarLite::Vertex& DStarLite::vertex(int id) {
+  Vertex& a = v[id];
+  if (a.gen != generation) {
+    a.g = 2147483647;
+    a.rhs = 2147483647;
+    a.gen = generation;
+  }
+  return a;
+}
+
+// Manhattan distance from the start cell, as the search runs backward
+int DStarLite::estimate(Coord a) {
+  return board.heuristic(start, a);
+}
+
+void DStarLite::key(Coord a, int& k1, int& k2) {
+  Vertex& x = vertex(board.index(a));
+  k2 = x.g < x.rhs ? x.g : x.rhs;
+  k1 = k2 == 2147483647 ? k2 : k2 + estimate(a) + km;
+}
+
+// Best distance to END through one of the free neighbors
+int DStarLite::lookahead(Coord a) {
+  if (board.isWall(a)) return 2147483647;
+  Coord next[4] = {{a.x - 1, a.y}, {a.x + 1, a.y}, {a.x, a.y - 1}, {a.x, a.y + 1}};
+  int best = 2147483647;
+  for (int i=0; i<4; i++) {
+    if (!board.isFree(next[i])) continue;
+    int g = vertex(board.index(next[i])).g;
+    if (g != 2147483647 && g + 1 < best) best = g + 1;
+  }
+  return best;
+}
+
+// Recompute rhs, and keep the cell in the open set only if it is inconsistent
+void DStarLite::updateVertex(Coord a) {
+  if (!board.inside(a)) return;
+  int id = board.index(a);
+  Vertex& x = vertex(id);
+  if (a.x != end.x || a.y != end.y) x.rhs = lookahead(a);
+
+  bool open = queue.contains(id);
+  if (x.g != x.rhs) {
+    int k1, k2;
+    key(a, k1, k2);
+    if (open) {
+      queue.update(id, k1, k2);
+    } else {
+      queue.push(id, k1, k2);
+      generated.push_back(id);
+    }
+  } else if (open) {
+    queue.remove(id);
+  }
+}
@@ -0,0 +1,39 @@
+#ifndef __DSTARLITE_HPP__
+#define __DSTARLITE_HPP__
+
+#include <vector>
+#include "astar.hpp"
+
+// D* Lite on 4-connected grids: the search grows backward from the END cell
+// and is kept between searches, so toggled walls only repair the part of the
+// search tree they affect, and a moving start only shifts the keys by km
+// g is the settled distance to END, rhs the one-step lookahead from the
+// neighbors, and a cell is in the open set while the two disagree
+class DStarLite : public AStar {
+public:
+  // Search state of a cell, only valid if gen matches the current plan
+  typedef struct Vertex {
+    int g, rhs;
+    unsigned int gen;
+  } Vertex;
+
+  std::vector<Vertex> v;
+  OpenSet queue; // Ordered by the two keys, whatever open set AStar uses
+  int km;     // Sum of the heuristic between the successive start cells
+  Coord last; // Start cell when km was last updated
+  bool planned;
+
+  DStarLite(const Board& board);
+  void init(Coord start, Coord end);
+  State step();
+  std::vector<Coord> path();
+  void update(Coord a);
+
+  Vertex& vertex(int id);
+  int estimate(Coord a);
+  void key(Coord a, int& k1, int& k2);
+  int lookahead(Coord a);
+  void updateVertex(Coord a);
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include "flowfield.hpp"
+
+// Directions to the 4 neighbors, k^1 being the opposite of k
+static const int DX[4] = {-1, 1, 0, 0};
+static const int DY[4] = {0, 0, -1, 1};
+
+// Constructor, the field is built by the first search
+FlowField::FlowField(const Board& board) : AStar(board), queue(board.width*board.height) {
+  goal = {-1, -1};
+}
+
+// Reuse the field if it already leads to END, the path is then only followed
+void FlowField::init(Coord start, Coord end) {
+  this->start = start;
+  this->end = end;
+  generated.clear();
+  expanded = 0;
+  if (dist.empty() || goal.x != end.x || goal.y != end.y) build(end);
+  state = distance(start) < 2147483647 ? FOUND : NO_PATH;
+}
+
+// The field is complete after init
+AStar::State FlowField::step() {
+  return state;
+}
+
+// Follow the field from start to the goal
+std::vector<Coord> FlowField::path() {
+  if (state != FOUND) return std::vector<Coord>();
+  std::vector<Coord> result(1, start);
+  for (Coord cur = start; cur.x != goal.x || cur.y != goal.y; ) {
+    cur = next(cur);
+    result.push_back(cur);
+  }
+  return result;
+}
+
+// Dijkstra search from the goal over the whole board, expanded counting its cells
+void FlowField::build(Coord goal) {
+  this->goal = goal;
+  generated.clear();
+  expanded = 0;
+  dist.assign(board.width*board.height, 2147483647);
+  dir.assign(board.width*board.height, -1);
+  queue.clear();
+  if (!board.isFree(goal)) return;
+  settle(board.index(goal), 0, -1);
+  propagate();
+}
+
+// Recompute the cells whose way to the goal went through a toggled cell,
+// then let any shorter way through it spread to the rest of the field
+void FlowField::update(Coord a) {
+  if (dist.empty() || !board.inside(a)) return;
+  generated.clear();
+  expanded = 0;
+  if (a.x == goal.x && a.y == goal.y) {
+    build(goal);
+    return;
+  }
+
+  // The cells stepping to a, directly or not, lose their way to the goal
+  stale.assign(1, board.index(a));
+  for (int i=0; i<(int)stale.size(); i++) {
+    Coord cur = board.coord(stale[i]);
+    for (int k=0; k<4; k++) {
+      Coord b = {cur.x + DX[k], cur.y + DY[k]};
+      if (board.inside(b) && dir[board.index(b)] == (k ^ 1)) stale.push_back(board.index(b));
+    }
+  }
+  for (int i=0; i<(int)stale.size(); i++) {
+    dist[stale[i]] = 2147483647;
+    dir[stale[i]] = -1;
+  }
+
+  // Each of them starts again from its best neighbor left untouched
+  for (int i=0; i<(int)stale.size(); i++) {
+    Coord cur = board.coord(stale[i]);
+    if (!board.isFree(cur)) continue;
+    int best = 2147483647, way = -1;
+    for (int k=0; k<4; k++) {
+      Coord b = {cur.x + DX[k], cur.y + DY[k]};
+      if (!board.isFree(b) || dist[board.index(b)] == 2147483647) continue;
+      int d = dist[board.index(b)] + board.cell(b).cost;
+      if (d < best) {
+        best = d;
+        way = k;
+      }
+    }
+    if (way != -1) settle(stale[i], best, way);
+  }
+  propagate();
+}
+
+// Neighbor to step to from a, a itself at the goal or if the goal is unreachable
+Coord FlowField::next(Coord a) const {
+  if (!board.inside(a)) return a;
+  int k = dir[board.index(a)];
+  if (k == -1) return a;
+  return {a.x + DX[k], a.y + DY[k]};
+}
+
+// Cost from a to the goal, INT_MAX if unreachable
+int FlowField::distance(Coord a) const {
+  if (dist.empty() || !board.inside(a)) return 2147483647;
+  return dist[board.index(a)];
+}
+
+// Give a cell a shorter cost through its neighbor k
+void FlowField::settle(int id, int d, int k) {
+  dist[id] = d;
+  dir[id] = (signed char)k;
+  if (queue.contains(id)) queue.decrease(id, d, 0);
+  else queue.push(id, d, 0);
+}
+
+// Spread the queued costs, a move into a cell costs its terrain
+void FlowField::propagate() {
+  while (!queue.empty()) {
+    int id = queue.pop();
+    Coord cur = board.coord(id);
+    int d = dist[id] + board.cell(cur).cost;
+    expanded++;
+    generated.push_back(id);
+    for (int k=0; k<4; k++) {
+      Coord b = {cur.x + DX[k], cur.y + DY[k]};
+      if (!board.isFree(b) || d >= dist[board.index(b)]) continue;
+      settle(board.index(b), d, k ^ 1);
+    }
+  }
+}
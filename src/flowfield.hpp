@@ -0,0 +1,33 @@
+#ifndef __FLOWFIELD_HPP__
+#define __FLOWFIELD_HPP__
+
+#include <vector>
+#include "astar.hpp"
+
+// Flow field towards one goal, for many agents sharing it: a Dijkstra search
+// from the goal gives every cell its cost to the goal and the neighbor to
+// step to, so an agent anywhere moves with one lookup per cell
+// A search with the same END reuses the field, and a toggled wall or terrain
+// cost only recomputes the cells whose way to the goal went through it
+class FlowField : public AStar {
+public:
+  Coord goal;
+  std::vector<int> dist;         // Cost to the goal, INT_MAX if unreachable
+  std::vector<signed char> dir;  // Neighbor towards the goal, -1 at the goal or if unreachable
+  OpenSet queue;
+  std::vector<int> stale;        // Cells whose way to the goal is being recomputed
+
+  FlowField(const Board& board);
+  void init(Coord start, Coord end);
+  State step();
+  std::vector<Coord> path();
+  void build(Coord goal);
+  void update(Coord a);
+  Coord next(Coord a) const;
+  int distance(Coord a) const;
+
+  void settle(int id, int d, int k);
+  void propagate();
+};
+
+#endif
@@ -0,0 +1,35 @@
+#include "gridastar.hpp"
+
+// Constructor
+GridAStar<8>::GridAStar(const Board& board, CornerRule corners) : AStar(board), corners(corners) {
+}
+
+// Octile distance to the END cell, scaled by the cheapest terrain
+int GridAStar<8>::estimate(Coord a) {
+  return board.octile(a, end) * board.minCost();
+}
+
+// Check the 4 straight then the 4 diagonal neighbors, scaled by the terrain entered
+void GridAStar<8>::expand(Coord cur) {
+  int dirs[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+  for (int k=0; k<8; k++) {
+    int dx = dirs[k][0];
+    int dy = dirs[k][1];
+    Coord b = {cur.x + dx, cur.y + dy};
+    if (!board.isFree(b)) continue;
+    if (k < 4) {
+      processNeighbor(cur, b, STRAIGHT_COST*board.cell(b).cost);
+    } else if (canCut(cur, dx, dy)) {
+      processNeighbor(cur, b, DIAGONAL_COST*board.cell(b).cost);
+    }
+  }
+}
+
+// Apply the corner rule to a diagonal move from cur
+bool GridAStar<8>::canCut(Coord cur, int dx, int dy) {
+  bool horizontal = board.isFree({cur.x + dx, cur.y});
+  bool vertical = board.isFree({cur.x, cur.y + dy});
+  if (corners == CUT_NEVER) return horizontal && vertical;
+  if (corners == CUT_ONE_FREE) return horizontal || vertical;
+  return true;
+}
@@ -0,0 +1,37 @@
+#ifndef __GRIDASTAR_HPP__
+#define __GRIDASTAR_HPP__
+
+#include "astar.hpp"
+
+// Whether a diagonal move may pass next to a wall
+// CUT_NEVER: both straight cells beside the move must be free
+// CUT_ONE_FREE: one of them is enough, but never between two walls
+// CUT_ALWAYS: any diagonal move between two free cells
+typedef enum CornerRule {
+  CUT_NEVER, CUT_ONE_FREE, CUT_ALWAYS
+} CornerRule;
+
+// A* with the neighbors of a cell chosen at compile time
+template <int Neighbors>
+class GridAStar;
+
+// 4-connected: the plain AStar, terrain costs and the Manhattan distance scaled by minCost()
+template <>
+class GridAStar<4> : public AStar {
+public:
+  GridAStar(const Board& board) : AStar(board) {}
+};
+
+// 8-connected: STRAIGHT_COST and DIAGONAL_COST moves and the octile distance
+template <>
+class GridAStar<8> : public AStar {
+public:
+  CornerRule corners;
+
+  GridAStar(const Board& board, CornerRule corners = CUT_NEVER);
+  int estimate(Coord a);
+  void expand(Coord cur);
+  bool canCut(Coord cur, int dx, int dy);
+};
+
+#endif
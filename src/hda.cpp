@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <thread>
+#include "hda.hpp"
+
+// Messages a mailbox holds before the sender keeps them in its outbox
+#define MAILBOX_SIZE 4096
+
+// Threads to use, one per hardware thread unless given
+static int threadCount(int threads) {
+  if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+  return threads > 0 ? threads : 1;
+}
+
+// Constructor
+HDAStar::HDAStar(const Board& board, int threads) : board(board), threads(threadCount(threads)),
+    n(board.width*board.height), mailboxes(this->threads*this->threads) {
+  for (int i=0; i<(int)mailboxes.size(); i++) {
+    mailboxes[i].ring.resize(MAILBOX_SIZE);
+    mailboxes[i].head = 0;
+    mailboxes[i].tail = 0;
+  }
+  for (int i=0; i<this->threads; i++) {
+    Worker w = {OpenSet(board.width*board.height), std::vector<std::vector<Message> >(this->threads), 0};
+    workers.push_back(w);
+  }
+  for (int i=0; i<(int)n.size(); i++) {
+    n[i].gen = 0;
+  }
+  generation = 0;
+  best = 2147483647;
+  work = 0;
+  start = {-1, -1};
+  end = {-1, -1};
+  expanded = 0;
+}
+
+// Search from start to end with every thread
+std::vector<Coord> HDAStar::findPath(Coord start, Coord end) {
+  this->start = start;
+  this->end = end;
+  std::vector<Coord> result;
+  if (!board.isFree(start) || !board.isFree(end)) return result;
+
+  if (++generation == 0) {
+    for (int i=0; i<(int)n.size(); i++) {
+      n[i].gen = 0;
+    }
+    generation = 1;
+  }
+  for (int t=0; t<threads; t++) {
+    workers[t].openSet.clear();
+    workers[t].expanded = 0;
+  }
+  best = 2147483647;
+  work = threads;
+
+  // The owner of the start cell begins, the others wait for messages
+  relax(owner(board.index(start)), board.index(start), 0, -1);
+  std::vector<std::thread> pool;
+  for (int t=1; t<threads; t++) {
+    pool.push_back(std::thread(&HDAStar::run, this, t));
+  }
+  run(0);
+  for (int i=0; i<(int)pool.size(); i++) {
+    pool[i].join();
+  }
+
+  expanded = 0;
+  for (int t=0; t<threads; t++) {
+    expanded += workers[t].expanded;
+  }
+  if (best == 2147483647) return result;
+
+  // Every parent has a lower g, so the walk ends at the start cell
+  for (int id = board.index(end); id != -1; id = n[id].parent) {
+    result.push_back(board.coord(id));
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+// Thread owning a cell, hashed so that every region is spread over the threads
+int HDAStar::owner(int id) const {
+  return (int)(((unsigned int)id * 2654435761u) >> 16) % threads;
+}
+
+// Search loop of one thread
+void HDAStar::run(int t) {
+  Worker& w = workers[t];
+  int goal = board.index(end);
+  bool busy = true;
+  while (true) {
+    // Take the messages sent by the other threads
+    for (int s=0; s<threads; s++) {
+      if (s == t) continue;
+      Mailbox& m = mailboxes[s*threads + t];
+      unsigned int head = m.head.load(std::memory_order_relaxed);
+      unsigned int tail = m.tail.load(std::memory_order_acquire);
+      for (; head != tail; head++) {
+        // Count this thread busy again before the message stops counting
+        if (!busy) {
+          work++;
+          busy = true;
+        }
+        const Message& msg = m.ring[head % MAILBOX_SIZE];
+        relax(t, msg.id, msg.g, msg.parent);
+        work--;
+      }
+      m.head.store(head, std::memory_order_release);
+    }
+    flush(t);
+
+    // Nothing below the best path is left here, wait until the others are done
+    if (w.openSet.empty() || w.openSet.heap[0].f >= best.load()) {
+      if (busy) {
+        busy = false;
+        work--;
+      }
+      if (work.load() == 0) return;
+      std::this_thread::yield();
+      continue;
+    }
+
+    int id = w.openSet.pop();
+    int g = node(id).g;
+    w.expanded++;
+    if (id == goal) {
+      int b = best.load();
+      while (g < b && !best.compare_exchange_weak(b, g));
+      continue;
+    }
+
+    Coord cur = board.coord(id);
+    Coord next[4] = {{cur.x-1, cur.y}, {cur.x+1, cur.y}, {cur.x, cur.y-1}, {cur.x, cur.y+1}};
+    for (int i=0; i<4; i++) {
+      if (!board.isFree(next[i])) continue;
+      if (g + 1 + board.heuristic(next[i], end) >= best.load()) continue;
+      int nb = board.index(next[i]);
+      int to = owner(nb);
+      Message m = {nb, g + 1, id};
+      if (to == t) {
+        relax(t, nb, g + 1, id);
+      } else {
+        work++;
+        send(t, to, m);
+      }
+    }
+  }
+}
+
+// Reach a cell owned by thread t, reopening it if it was already expanded
+void HDAStar::relax(int t, int id, int g, int parent) {
+  Node& a = node(id);
+  if (g >= a.g) return;
+  a.g = g;
+  a.parent = parent;
+  int h = board.heuristic(board.coord(id), end);
+  OpenSet& openSet = workers[t].openSet;
+  if (openSet.contains(id)) {
+    openSet.decrease(id, g + h, h);
+  } else {
+    openSet.push(id, g + h, h);
+  }
+}
+
+// Post a message, or keep it in the outbox while the mailbox is full
+void HDAStar::send(int t, int to, const Message& m) {
+  std::vector<Message>& outbox = workers[t].outbox[to];
+  Mailbox& box = mailboxes[t*threads + to];
+  unsigned int tail = box.tail.load(std::memory_order_relaxed);
+  if (!outbox.empty() || tail - box.head.load(std::memory_order_acquire) == MAILBOX_SIZE) {
+    outbox.push_back(m);
+    return;
+  }
+  box.ring[tail % MAILBOX_SIZE] = m;
+  box.tail.store(tail + 1, std::memory_order_release);
+}
+
+// Move what the outboxes of thread t hold into the mailboxes with room
+void HDAStar::flush(int t) {
+  for (int to=0; to<threads; to++) {
+    std::vector<Message>& outbox = workers[t].outbox[to];
+    if (outbox.empty()) continue;
+    Mailbox& box = mailboxes[t*threads + to];
+    unsigned int tail = box.tail.load(std::memory_order_relaxed);
+    unsigned int room = MAILBOX_SIZE - (tail - box.head.load(std::memory_order_acquire));
+    unsigned int count = std::min(room, (unsigned int)outbox.size());
+    for (unsigned int i=0; i<count; i++) {
+      box.ring[(tail + i) % MAILBOX_SIZE] = outbox[i];
+    }
+    box.tail.store(tail + count, std::memory_order_release);
+    outbox.erase(outbox.begin(), outbox.begin() + count);
+  }
+}
+
+// Search state of a cell, a stale one is reset on first access by its owner
+HDAStar::Node& HDAStar::node(int id) {
+  Node& a = n[id];
+  if (a.gen != generation) {
+    a.g = 2147483647;
+    a.parent = -1;
+    a.gen = generation;
+  }
+  return a;
+}
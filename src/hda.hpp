@@ -0,0 +1,63 @@
+#ifndef __HDA_HPP__
+#define __HDA_HPP__
+
+#include <atomic>
+#include <vector>
+#include "board.hpp"
+#include "openset.hpp"
+
+// Hash-distributed A* (HDA*) on 4-connected grids: one query shared by
+// several threads, each cell owned by the thread its index hashes to
+// A thread only expands and updates the cells it owns, and sends the
+// neighbors owned by others through lock-free single-producer mailboxes
+// A cell may be expanded again if a shorter path to it arrives later, and
+// the search ends once no thread has a cell with fScore below the best path
+// and no message is left in flight, which keeps the path optimal
+class HDAStar {
+public:
+  // A cell reached by another thread
+  typedef struct Message {
+    int id, g, parent;
+  } Message;
+
+  // Ring buffer from one thread to another
+  typedef struct Mailbox {
+    std::vector<Message> ring;
+    std::atomic<unsigned int> head, tail;
+  } Mailbox;
+
+  // Search state of a cell, written only by its owner, valid if gen matches
+  typedef struct Node {
+    int g, parent;
+    unsigned int gen;
+  } Node;
+
+  typedef struct Worker {
+    OpenSet openSet;
+    std::vector<std::vector<Message> > outbox; // Messages waiting for a full mailbox, per thread
+    int expanded;
+  } Worker;
+
+  const Board& board;
+  int threads;
+  std::vector<Node> n;
+  unsigned int generation;
+  std::vector<Worker> workers;
+  std::vector<Mailbox> mailboxes; // Indexed by sender*threads + receiver
+  std::atomic<int> best;          // Cost of the best path found so far
+  std::atomic<int> work;          // Busy threads plus messages not yet received
+  Coord start, end;
+  int expanded;
+
+  HDAStar(const Board& board, int threads = 0);
+  std::vector<Coord> findPath(Coord start, Coord end);
+
+  int owner(int id) const;
+  void run(int t);
+  void relax(int t, int id, int g, int parent);
+  void send(int t, int to, const Message& m);
+  void flush(int t);
+  Node& node(int id);
+};
+
+#endif
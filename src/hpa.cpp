@@ -0,0 +1,330 @@
+#include <algorithm>
+#include "hpa.hpp"
+
+// A border run shorter than this gets one entrance in its middle, a longer one
+// gets an entrance at each end
+#define ENTRANCE_SPLIT 6
+
+// Constructor, every cluster is built before the first query
+HPA::HPA(const Board& board, int size) : board(board), size(size), openSet(2) {
+  columns = (board.width + size - 1) / size;
+  rows = (board.height + size - 1) / size;
+  clusters.resize(columns*rows);
+  for (int k=0; k<(int)clusters.size(); k++) {
+    clusters[k].offset = 0;
+    clusters[k].dirty = true;
+  }
+  dist.resize(size*size);
+  parent.resize(size*size);
+  generation = 0;
+  expanded = 0;
+  start = {-1, -1};
+  end = {-1, -1};
+  dirty = true;
+  refresh();
+}
+
+// A toggled cell changes its own cluster, and the entrances of the clusters
+// across any border it lies on
+void HPA::update(Coord a) {
+  if (!board.inside(a)) return;
+  int cx = a.x / size;
+  int cy = a.y / size;
+  clusters[cy*columns + cx].dirty = true;
+  if (a.x % size == 0 && cx > 0) clusters[cy*columns + cx-1].dirty = true;
+  if (a.x % size == size-1 && cx < columns-1) clusters[cy*columns + cx+1].dirty = true;
+  if (a.y % size == 0 && cy > 0) clusters[(cy-1)*columns + cx].dirty = true;
+  if (a.y % size == size-1 && cy < rows-1) clusters[(cy+1)*columns + cx].dirty = true;
+  dirty = true;
+}
+
+// Rebuild the changed clusters, then number the entrances of the abstract graph
+void HPA::refresh() {
+  if (!dirty) return;
+  owner.clear();
+  for (int k=0; k<(int)clusters.size(); k++) {
+    if (clusters[k].dirty) build(k);
+    clusters[k].offset = (int)owner.size();
+    owner.insert(owner.end(), clusters[k].cells.size(), k);
+  }
+
+  // Two more nodes for the start and end cells of a query
+  Node stale = {0, -1, 0, 0};
+  n.assign(owner.size() + 2, stale);
+  generation = 0;
+  openSet = OpenSet((int)owner.size() + 2);
+  dirty = false;
+}
+
+// Find the entrances of a cluster and the distances between them
+void HPA::build(int k) {
+  Cluster& c = clusters[k];
+  int cx = k % columns;
+  int cy = k / columns;
+  int x0 = cx*size, y0 = cy*size;
+  int w = std::min(size, board.width - x0);
+  int h = std::min(size, board.height - y0);
+
+  c.cells.clear();
+  if (cx > 0) addEntrances(k, {x0, y0}, 0, 1, h, -1, 0);
+  if (cx < columns-1) addEntrances(k, {x0+w-1, y0}, 0, 1, h, 1, 0);
+  if (cy > 0) addEntrances(k, {x0, y0}, 1, 0, w, 0, -1);
+  if (cy < rows-1) addEntrances(k, {x0, y0+h-1}, 1, 0, w, 0, 1);
+
+  int m = (int)c.cells.size();
+  c.dist.assign(m*m, -1);
+  for (int i=0; i<m; i++) {
+    explore(k, board.coord(c.cells[i]));
+    for (int j=0; j<m; j++) {
+      c.dist[i*m + j] = dist[local(k, board.coord(c.cells[j]))];
+    }
+  }
+  c.dirty = false;
+}
+
+// Scan one border, from first along (dx, dy), for runs of cells free on both
+// sides, the other side being at offset (ox, oy)
+// Both clusters scan the border the same way, so they agree on the entrances
+void HPA::addEntrances(int k, Coord first, int dx, int dy, int length, int ox, int oy) {
+  std::vector<int>& cells = clusters[k].cells;
+  int run = 0;
+  for (int i=0; i<=length; i++) {
+    Coord a = {first.x + dx*i, first.y + dy*i};
+    if (i < length && board.isFree(a) && board.isFree({a.x+ox, a.y+oy})) {
+      run++;
+      continue;
+    }
+    if (run == 0) continue;
+
+    // The run covers cells i-run to i-1
+    int picks[2] = {i - run + (run-1)/2, -1};
+    if (run >= ENTRANCE_SPLIT) {
+      picks[0] = i - run;
+      picks[1] = i - 1;
+    }
+    for (int p=0; p<2 && picks[p] != -1; p++) {
+      int id = board.index({first.x + dx*picks[p], first.y + dy*picks[p]});
+      // A corner cell may already be an entrance of the other border
+      if (std::find(cells.begin(), cells.end(), id) == cells.end()) cells.push_back(id);
+    }
+    run = 0;
+  }
+}
+
+// Breadth-first search from a free cell, without leaving its cluster
+// Fills dist (-1 if unreachable) and parent with local indices
+void HPA::explore(int k, Coord from) {
+  int x0 = (k % columns)*size, y0 = (k / columns)*size;
+  int x1 = std::min(x0 + size, board.width);
+  int y1 = std::min(y0 + size, board.height);
+
+  std::fill(dist.begin(), dist.end(), -1);
+  queue.clear();
+  int l = local(k, from);
+  dist[l] = 0;
+  parent[l] = -1;
+  queue.push_back(l);
+  for (int head=0; head<(int)queue.size(); head++) {
+    Coord cur = cellOf(k, queue[head]);
+    Coord next[4] = {{cur.x-1, cur.y}, {cur.x+1, cur.y}, {cur.x, cur.y-1}, {cur.x, cur.y+1}};
+    for (int i=0; i<4; i++) {
+      Coord b = next[i];
+      if (b.x < x0 || b.x >= x1 || b.y < y0 || b.y >= y1 || board.isWall(b)) continue;
+      int lb = local(k, b);
+      if (dist[lb] != -1) continue;
+      dist[lb] = dist[queue[head]] + 1;
+      parent[lb] = queue[head];
+      queue.push_back(lb);
+    }
+  }
+}
+
+// Search the abstract graph, then refine each segment of the abstract path
+std::vector<Coord> HPA::findPath(Coord start, Coord end) {
+  refresh();
+  this->start = start;
+  this->end = end;
+  expanded = 0;
+  visited.clear();
+  std::vector<Coord> result;
+  if (!board.isFree(start) || !board.isFree(end)) return result;
+
+  if (++generation == 0) {
+    for (int i=0; i<(int)n.size(); i++) {
+      n[i].gen = 0;
+    }
+    generation = 1;
+  }
+  openSet.clear();
+
+  // The start and end cells are linked to the entrances of their clusters
+  int total = (int)owner.size();
+  int ks = clusterOf(start);
+  int ke = clusterOf(end);
+  explore(ke, end);
+  endDist = dist;
+  explore(ks, start);
+  startDist = dist;
+
+  Node& s = node(total);
+  s.g = 0;
+  s.parent = -1;
+  s.set = AStar::IN_OPEN;
+  openSet.push(total, board.heuristic(start, end), board.heuristic(start, end));
+  while (!openSet.empty()) {
+    int u = openSet.pop();
+    node(u).set = AStar::IN_CLOSED;
+    if (u == total + 1) break;
+    expanded++;
+    Coord cur = nodeCell(u);
+    int k = nodeCluster(u);
+    visited.push_back(cur);
+
+    if (u == total) {
+      const Cluster& c = clusters[ks];
+      for (int j=0; j<(int)c.cells.size(); j++) {
+        int d = startDist[local(ks, board.coord(c.cells[j]))];
+        if (d >= 0) relax(u, c.offset + j, d);
+      }
+    } else {
+      // Entrances of the same cluster, then across the border
+      const Cluster& c = clusters[k];
+      int i = u - c.offset;
+      int m = (int)c.cells.size();
+      for (int j=0; j<m; j++) {
+        if (j != i && c.dist[i*m + j] >= 0) relax(u, c.offset + j, c.dist[i*m + j]);
+      }
+      Coord next[4] = {{cur.x-1, cur.y}, {cur.x+1, cur.y}, {cur.x, cur.y-1}, {cur.x, cur.y+1}};
+      for (int b=0; b<4; b++) {
+        if (!board.isFree(next[b])) continue;
+        int kb = clusterOf(next[b]);
+        if (kb == k) continue;
+        int j = entrance(kb, board.index(next[b]));
+        if (j >= 0) relax(u, clusters[kb].offset + j, 1);
+      }
+    }
+    if (k == ke && endDist[local(ke, cur)] >= 0) relax(u, total + 1, endDist[local(ke, cur)]);
+  }
+  if (!(node(total + 1).set & AStar::IN_CLOSED)) return result;
+
+  // Abstract path from the start node to the end node
+  std::vector<int> ids;
+  for (int u = total + 1; u != -1; u = node(u).parent) {
+    ids.push_back(u);
+  }
+  std::reverse(ids.begin(), ids.end());
+
+  // Refine the segments inside a cluster, a border crossing is a single step
+  result.push_back(start);
+  for (int i=1; i<(int)ids.size(); i++) {
+    int k = nodeCluster(ids[i-1]);
+    Coord a = nodeCell(ids[i-1]);
+    Coord b = nodeCell(ids[i]);
+    if (nodeCluster(ids[i]) != k) {
+      result.push_back(b);
+      continue;
+    }
+    explore(k, a);
+    int first = (int)result.size();
+    for (int l = local(k, b); l != local(k, a); l = parent[l]) {
+      result.push_back(cellOf(k, l));
+    }
+    std::reverse(result.begin() + first, result.end());
+  }
+  return result;
+}
+
+int HPA::clusterOf(Coord a) const {
+  return (a.y / size)*columns + a.x / size;
+}
+
+// Index of a cell inside its cluster
+int HPA::local(int k, Coord a) const {
+  return (a.y - (k / columns)*size)*size + a.x - (k % columns)*size;
+}
+
+Coord HPA::cellOf(int k, int l) const {
+  return {(k % columns)*size + l % size, (k / columns)*size + l / size};
+}
+
+// Index of a cell among the entrances of a cluster, -1 if it is not one
+int HPA::entrance(int k, int id) const {
+  const std::vector<int>& cells = clusters[k].cells;
+  for (int i=0; i<(int)cells.size(); i++) {
+    if (cells[i] == id) return i;
+  }
+  return -1;
+}
+
+Coord HPA::nodeCell(int id) const {
+  if (id == (int)owner.size()) return start;
+  if (id == (int)owner.size() + 1) return end;
+  return board.coord(clusters[owner[id]].cells[id - clusters[owner[id]].offset]);
+}
+
+int HPA::nodeCluster(int id) const {
+  if (id == (int)owner.size()) return clusterOf(start);
+  if (id == (int)owner.size() + 1) return clusterOf(end);
+  return owner[id];
+}
+
+// Search state of a node, a stale one is reset on first access
+HPA::Node& HPA::node(int id) {
+  Node& a = n[id];
+  if (a.gen != generation) {
+    a.g = 2147483647;
+    a.parent = -1;
+    a.set = 0;
+    a.gen = generation;
+  }
+  return a;
+}
+
+// Reach a node of the abstract graph at the given cost
+void HPA::relax(int from, int to, int cost) {
+  Node& b = node(to);
+  if (b.set & AStar::IN_CLOSED) return;
+  int g = node(from).g + cost;
+  if (g >= b.g) return;
+  int h = board.heuristic(nodeCell(to), end);
+  b.g = g;
+  b.parent = from;
+  if (b.set & AStar::IN_OPEN) {
+    openSet.decrease(to, g + h, h);
+  } else {
+    b.set = AStar::IN_OPEN;
+    openSet.push(to, g + h, h);
+  }
+}
+
+// Constructor
+HPAStar::HPAStar(const Board& board, HPA& hpa) : AStar(board), hpa(hpa) {
+  replayed = 0;
+}
+
+// The whole query runs here, the steps only replay it
+void HPAStar::init(Coord start, Coord end) {
+  this->start = start;
+  this->end = end;
+  result = hpa.findPath(start, end);
+  generated.clear();
+  expanded = 0;
+  replayed = 0;
+  state = SEARCHING;
+}
+
+AStar::State HPAStar::step() {
+  if (state != SEARCHING) return state;
+  if (replayed < (int)hpa.visited.size()) {
+    generated.push_back(board.index(hpa.visited[replayed++]));
+    expanded++;
+    return state;
+  }
+  state = result.empty() ? NO_PATH : FOUND;
+  return state;
+}
+
+std::vector<Coord> HPAStar::path() {
+  if (state != FOUND) return std::vector<Coord>();
+  return result;
+}
@@ -0,0 +1,79 @@
+#ifndef __HPA_HPP__
+#define __HPA_HPP__
+
+#include <vector>
+#include "astar.hpp"
+
+// Hierarchical pathfinding (HPA*) on 4-connected grids
+// The board is split into square clusters, and the cells where a path can
+// cross from one cluster to the next become entrances of an abstract graph
+// Entrances of a cluster are linked by distances precomputed inside it, so a
+// query searches the small abstract graph and only refines the segments used
+// Paths are near optimal, as they may only cross borders at entrances
+class HPA {
+public:
+  typedef struct Cluster {
+    std::vector<int> cells; // Entrance cells
+    std::vector<int> dist;  // Distance between two entrances inside the cluster, -1 if none
+    int offset;             // Id of the first entrance in the abstract graph
+    bool dirty;
+  } Cluster;
+
+  // Search state of an abstract node, only valid if gen matches the current query
+  typedef struct Node {
+    int g;
+    int parent;
+    unsigned char set;
+    unsigned int gen;
+  } Node;
+
+  const Board& board;
+  int size; // Side of a cluster in cells
+  int columns, rows;
+  std::vector<Cluster> clusters;
+  std::vector<int> owner; // Cluster of every entrance in the abstract graph
+  bool dirty;
+
+  std::vector<Node> n;
+  unsigned int generation;
+  OpenSet openSet;
+  Coord start, end;
+  std::vector<int> startDist, endDist; // Distances from start and end inside their clusters
+  int expanded;
+  std::vector<Coord> visited; // Entrances in the order they were expanded
+
+  // Scratch of a search inside one cluster
+  std::vector<int> dist, parent, queue;
+
+  HPA(const Board& board, int size = 16);
+  void update(Coord a);
+  void refresh();
+  void build(int k);
+  void addEntrances(int k, Coord first, int dx, int dy, int length, int ox, int oy);
+  void explore(int k, Coord from);
+  std::vector<Coord> findPath(Coord start, Coord end);
+
+  int clusterOf(Coord a) const;
+  int local(int k, Coord a) const;
+  Coord cellOf(int k, int l) const;
+  int entrance(int k, int id) const;
+  Coord nodeCell(int id) const;
+  int nodeCluster(int id) const;
+  Node& node(int id);
+  void relax(int from, int to, int cost);
+};
+
+// Front end for HPA, replaying the entrances expanded by a query one per step
+class HPAStar : public AStar {
+public:
+  HPA& hpa;
+  std::vector<Coord> result;
+  int replayed;
+
+  HPAStar(const Board& board, HPA& hpa);
+  void init(Coord start, Coord end);
+  State step();
+  std::vector<Coord> path();
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "jps.hpp"
+
+// Constructor
+JPS::JPS(const Board& board, Connectivity connectivity) : AStar(board), connectivity(connectivity) {
+}
+
+// Manhattan distance for FOUR, octile distance for EIGHT
+int JPS::estimate(Coord a) {
+  if (connectivity == FOUR) return board.heuristic(a, end);
+  return board.octile(a, end);
+}
+
+bool JPS::isFree(int x, int y) {
+  return board.isFree({x, y});
+}
+
+// Expand a jump point, only scanning the directions that are not pruned
+void JPS::expand(Coord cur) {
+  int x = cur.x;
+  int y = cur.y;
+  Coord parent = node(board.index(cur)).parent;
+
+  // The start cell scans every direction
+  if (parent.x == -1) {
+    jumpFrom(cur, 1, 0);
+    jumpFrom(cur, -1, 0);
+    jumpFrom(cur, 0, 1);
+    jumpFrom(cur, 0, -1);
+    if (connectivity == EIGHT) {
+      for (int dx=-1; dx<=1; dx+=2) {
+        for (int dy=-1; dy<=1; dy+=2) {
+          if (isFree(x+dx, y) && isFree(x, y+dy)) jumpFrom(cur, dx, dy);
+        }
+      }
+    }
+    return;
+  }
+
+  // Direction of travel from the parent
+  int dx = (x > parent.x) - (x < parent.x);
+  int dy = (y > parent.y) - (y < parent.y);
+
+  if (connectivity == FOUR) {
+    if (dx != 0) {
+      // Moving horizontally, turning is only needed past a wall behind
+      jumpFrom(cur, dx, 0);
+      if (isFree(x, y+1) && !isFree(x-dx, y+1)) jumpFrom(cur, 0, 1);
+      if (isFree(x, y-1) && !isFree(x-dx, y-1)) jumpFrom(cur, 0, -1);
+    } else {
+      // Moving vertically, both horizontal directions are natural
+      jumpFrom(cur, 0, dy);
+      jumpFrom(cur, 1, 0);
+      jumpFrom(cur, -1, 0);
+    }
+    return;
+  }
+
+  if (dx != 0 && dy != 0) {
+    // Moving diagonally
+    bool horizontal = isFree(x+dx, y);
+    bool vertical = isFree(x, y+dy);
+    if (vertical) jumpFrom(cur, 0, dy);
+    if (horizontal) jumpFrom(cur, dx, 0);
+    if (horizontal && vertical) jumpFrom(cur, dx, dy);
+  } else if (dx != 0) {
+    // Moving horizontally, turning is only needed past a wall behind
+    bool next = isFree(x+dx, y);
+    if (next) jumpFrom(cur, dx, 0);
+    for (int side=-1; side<=1; side+=2) {
+      if (isFree(x, y+side) && !isFree(x-dx, y+side)) {
+        jumpFrom(cur, 0, side);
+        if (next) jumpFrom(cur, dx, side);
+      }
+    }
+  } else {
+    // Moving vertically
+    bool next = isFree(x, y+dy);
+    if (next) jumpFrom(cur, 0, dy);
+    for (int side=-1; side<=1; side+=2) {
+      if (isFree(x+side, y) && !isFree(x+side, y-dy)) {
+        jumpFrom(cur, side, 0);
+        if (next) jumpFrom(cur, side, dy);
+      }
+    }
+  }
+}
+
+// Scan from cur in one direction and add the jump point found, if any
+void JPS::jumpFrom(Coord cur, int dx, int dy) {
+  Coord result;
+  if (!jump({cur.x+dx, cur.y+dy}, dx, dy, result)) return;
+  int cost = connectivity == FOUR ? board.heuristic(cur, result) : board.octile(cur, result);
+  processNeighbor(cur, result, cost);
+}
+
+bool JPS::jump(Coord a, int dx, int dy, Coord& result) {
+  if (connectivity == FOUR) return jumpFour(a, dx, dy, result);
+  return jumpEight(a, dx, dy, result);
+}
+
+// Walk from a in direction (dx, dy) until a jump point, false if a wall is hit first
+bool JPS::jumpFour(Coord a, int dx, int dy, Coord& result) {
+  Coord ignored;
+  while (true) {
+    if (!isFree(a.x, a.y)) return false;
+    if (a.x == end.x && a.y == end.y) break;
+
+    if (dx != 0) {
+      // A forced neighbor appears when the cell behind it is a wall
+      if ((isFree(a.x, a.y+1) && !isFree(a.x-dx, a.y+1)) || (isFree(a.x, a.y-1) && !isFree(a.x-dx, a.y-1))) break;
+    } else {
+      // A vertical scan stops wherever a horizontal scan finds a jump point
+      if (jumpFour({a.x+1, a.y}, 1, 0, ignored) || jumpFour({a.x-1, a.y}, -1, 0, ignored)) break;
+    }
+    a = {a.x+dx, a.y+dy};
+  }
+  result = a;
+  return true;
+}
+
+bool JPS::jumpEight(Coord a, int dx, int dy, Coord& result) {
+  Coord ignored;
+  while (true) {
+    if (!isFree(a.x, a.y)) return false;
+    if (a.x == end.x && a.y == end.y) break;
+
+    if (dx != 0 && dy != 0) {
+      // A diagonal scan stops wherever a straight scan finds a jump point
+      if (jumpEight({a.x+dx, a.y}, dx, 0, ignored) || jumpEight({a.x, a.y+dy}, 0, dy, ignored)) break;
+    } else if (dx != 0) {
+      if ((isFree(a.x, a.y-1) && !isFree(a.x-dx, a.y-1)) || (isFree(a.x, a.y+1) && !isFree(a.x-dx, a.y+1))) break;
+    } else {
+      if ((isFree(a.x-1, a.y) && !isFree(a.x-1, a.y-dy)) || (isFree(a.x+1, a.y) && !isFree(a.x+1, a.y-dy))) break;
+    }
+
+    // Diagonal moves may not cut a corner
+    if (!isFree(a.x+dx, a.y) || !isFree(a.x, a.y+dy)) return false;
+    a = {a.x+dx, a.y+dy};
+  }
+  result = a;
+  return true;
+}
@@ -0,0 +1,30 @@
+#ifndef __JPS_HPP__
+#define __JPS_HPP__
+
+#include "astar.hpp"
+
+// Jump Point Search for uniform-cost grids
+// Instead of every neighbor, only the jump points reached by scanning along
+// each canonical direction are added to the open set, pruning symmetric paths
+// FOUR is JPS for 4-connected grids (vertical moves before horizontal ones),
+// EIGHT moves diagonally only when both adjacent straight cells are free
+class JPS : public AStar {
+public:
+  typedef enum Connectivity {
+    FOUR, EIGHT
+  } Connectivity;
+
+  Connectivity connectivity;
+
+  JPS(const Board& board, Connectivity connectivity);
+  int estimate(Coord a);
+  void expand(Coord cur);
+
+  bool isFree(int x, int y);
+  bool jump(Coord a, int dx, int dy, Coord& result);
+  bool jumpFour(Coord a, int dx, int dy, Coord& result);
+  bool jumpEight(Coord a, int dx, int dy, Coord& result);
+  virtual void jumpFrom(Coord cur, int dx, int dy);
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include <cstdlib>
+#include "jpsplus.hpp"
+
+// Longest distance stored, a longer scan gets an extra jump point every JUMP_CAP cells
+#define JUMP_CAP 32767
+
+// Constructor
+JumpTable::JumpTable(const Board& board) : board(board) {
+  build();
+}
+
+// Index of a direction in the table: 4 straight then 4 diagonal directions
+int JumpTable::direction(int dx, int dy) {
+  if (dy == 0) return dx > 0 ? 0 : 1;
+  if (dx == 0) return dy > 0 ? 2 : 3;
+  if (dx > 0) return dy > 0 ? 4 : 5;
+  return dy > 0 ? 6 : 7;
+}
+
+int JumpTable::distance(Coord a, int dx, int dy) const {
+  return d[8*board.index(a) + direction(dx, dy)];
+}
+
+// A toggled cell invalidates the table, which is rebuilt before the next search
+void JumpTable::update(Coord) {
+  dirty = true;
+}
+
+void JumpTable::refresh() {
+  if (dirty) build();
+}
+
+// Precompute every distance, each direction in one sweep against it
+void JumpTable::build() {
+  int dirs[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+  d.assign(8*board.width*board.height, 0);
+
+  for (int k=0; k<8; k++) {
+    int dx = dirs[k][0];
+    int dy = dirs[k][1];
+    for (int j=0; j<board.height; j++) {
+      int y = dy > 0 ? board.height-1-j : j;
+      for (int i=0; i<board.width; i++) {
+        int x = dx > 0 ? board.width-1-i : i;
+        if (!isFree(x, y)) continue;
+
+        Coord b = {x+dx, y+dy};
+        short v = 0;
+        if (dx == 0 || dy == 0) {
+          // Straight: stop at the first cell with a forced neighbor
+          if (!isFree(b.x, b.y)) v = 0;
+          else if (isJumpPoint(b, dx, dy)) v = 1;
+          else v = next(d[8*board.index(b) + k]);
+        } else {
+          // Diagonal: stop where a straight scan finds a jump point, never cut a corner
+          if (!isFree(b.x, b.y) || !isFree(x+dx, y) || !isFree(x, y+dy)) v = 0;
+          else if (distance(b, dx, 0) > 0 || distance(b, 0, dy) > 0) v = 1;
+          else v = next(d[8*board.index(b) + k]);
+        }
+        d[8*board.index({x, y}) + k] = v;
+      }
+    }
+  }
+  dirty = false;
+}
+
+bool JumpTable::isFree(int x, int y) const {
+  return board.isFree({x, y});
+}
+
+// Check if a cell entered in a straight direction has a forced neighbor
+bool JumpTable::isJumpPoint(Coord b, int dx, int dy) const {
+  if (dx != 0) {
+    return (isFree(b.x, b.y+1) && !isFree(b.x-dx, b.y+1)) || (isFree(b.x, b.y-1) && !isFree(b.x-dx, b.y-1));
+  }
+  return (isFree(b.x+1, b.y) && !isFree(b.x+1, b.y-dy)) || (isFree(b.x-1, b.y) && !isFree(b.x-1, b.y-dy));
+}
+
+// Distance one cell further back than k
+short JumpTable::next(short k) const {
+  if (abs(k) >= JUMP_CAP) return 1;
+  return k > 0 ? k+1 : k-1;
+}
+
+// Constructor
+JPSPlus::JPSPlus(const Board& board, JumpTable& table) : JPS(board, JPS::EIGHT), table(table) {
+}
+
+// Rebuild the table if the board changed, then start the search
+void JPSPlus::init(Coord start, Coord end) {
+  table.refresh();
+  JPS::init(start, end);
+}
+
+// Look up the jump point in one direction instead of scanning for it
+void JPSPlus::jumpFrom(Coord cur, int dx, int dy) {
+  int dist = table.distance(cur, dx, dy);
+  int reach = abs(dist);
+  int gx = (end.x - cur.x) * dx;
+  int gy = (end.y - cur.y) * dy;
+
+  if (dx == 0 || dy == 0) {
+    // The END cell lies ahead on this line, before any wall
+    int ahead = dx != 0 ? (end.y == cur.y ? gx : 0) : (end.x == cur.x ? gy : 0);
+    if (ahead > 0 && ahead <= reach) {
+      processNeighbor(cur, end, STRAIGHT_COST*ahead);
+      return;
+    }
+    if (dist > 0) processNeighbor(cur, {cur.x + dx*dist, cur.y + dy*dist}, STRAIGHT_COST*dist);
+    return;
+  }
+
+  // The END cell is in this quadrant, stop on its row or column
+  if (gx > 0 && gy > 0) {
+    int steps = gx < gy ? gx : gy;
+    if (steps <= reach) {
+      processNeighbor(cur, {cur.x + dx*steps, cur.y + dy*steps}, DIAGONAL_COST*steps);
+      return;
+    }
+  }
+  if (dist > 0) processNeighbor(cur, {cur.x + dx*dist, cur.y + dy*dist}, DIAGONAL_COST*dist);
+}
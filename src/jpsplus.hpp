@@ -0,0 +1,39 @@
+#ifndef __JPSPLUS_HPP__
+#define __JPSPLUS_HPP__
+
+#include <vector>
+#include "jps.hpp"
+
+// Jump distances of every cell in the 8 directions, precomputed for JPS+
+// A positive distance k means a jump point k cells away, zero or a negative
+// distance -k means k free cells before a wall or a corner that cannot be cut
+class JumpTable {
+public:
+  const Board& board;
+  std::vector<short> d; // 8 distances per cell, indexed by direction()
+  bool dirty;
+
+  JumpTable(const Board& board);
+  static int direction(int dx, int dy);
+  int distance(Coord a, int dx, int dy) const;
+  void update(Coord a);
+  void refresh();
+  void build();
+
+  bool isFree(int x, int y) const;
+  bool isJumpPoint(Coord b, int dx, int dy) const;
+  short next(short k) const;
+};
+
+// JPS+ on 8-connected grids: the same pruning as JPS::EIGHT, but every scan is
+// a lookup in the jump table, with the END cell checked on the fly
+class JPSPlus : public JPS {
+public:
+  JumpTable& table;
+
+  JPSPlus(const Board& board, JumpTable& table);
+  void init(Coord start, Coord end);
+  void jumpFrom(Coord cur, int dx, int dy);
+};
+
+#endif
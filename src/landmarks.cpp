@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "landmarks.hpp"
+
+// Distance to a cell no landmark search reached
+#define UNREACHABLE 0xFFFFFFFFu
+
+// Constructor, the table is built right away
+LandmarkTable::LandmarkTable(const Board& board, int count, int threads) : board(board), count(count) {
+  if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+  this->threads = threads > 0 ? threads : 1;
+  buildTime = 0;
+  build();
+}
+
+// A toggled cell or terrain cost invalidates the table, rebuilt before the next search
+void LandmarkTable::update(Coord) {
+  dirty = true;
+}
+
+void LandmarkTable::refresh() {
+  if (dirty) build();
+}
+
+// Select the landmarks, then run one Dijkstra search per landmark on the threads
+void LandmarkTable::build() {
+  auto begin = std::chrono::steady_clock::now();
+  select();
+  int k = (int)landmarks.size();
+  int cells = board.width*board.height;
+
+  // Each landmark fills its own slice, interleaved per cell afterwards
+  std::vector<unsigned int> slices((size_t)k*cells);
+  std::atomic<int> next(0);
+  std::vector<std::thread> pool;
+  for (int t=0; t<threads && t<k; t++) {
+    pool.push_back(std::thread([this, k, cells, &slices, &next]() {
+      std::vector<unsigned int> dist;
+      OpenSet openSet(cells);
+      for (int l = next++; l < k; l = next++) {
+        explore(landmarks[l], dist, openSet);
+        std::copy(dist.begin(), dist.end(), slices.begin() + (size_t)l*cells);
+      }
+    }));
+  }
+  for (int t=0; t<(int)pool.size(); t++) {
+    pool[t].join();
+  }
+
+  unsigned int longest = 0;
+  for (size_t i=0; i<slices.size(); i++) {
+    if (slices[i] != UNREACHABLE && slices[i] > longest) longest = slices[i];
+  }
+  narrow.clear();
+  wide.clear();
+  if (longest < 65535) {
+    narrow.resize((size_t)k*cells);
+    for (int i=0; i<cells; i++) {
+      for (int l=0; l<k; l++) {
+        unsigned int d = slices[(size_t)l*cells + i];
+        narrow[(size_t)i*k + l] = d == UNREACHABLE ? 65535 : (unsigned short)d;
+      }
+    }
+  } else {
+    wide.resize((size_t)k*cells);
+    for (int i=0; i<cells; i++) {
+      for (int l=0; l<k; l++) {
+        wide[(size_t)i*k + l] = slices[(size_t)l*cells + i];
+      }
+    }
+  }
+  dirty = false;
+  buildTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+// Spread the landmarks evenly along the border, each moved to the nearest free cell
+void LandmarkTable::select() {
+  landmarks.clear();
+  int perimeter = 2*(board.width - 1) + 2*(board.height - 1);
+  if (perimeter <= 0) perimeter = 1;
+  for (int l=0; l<count; l++) {
+    // Walk the border clockwise from the bottom-left corner
+    int p = (int)((long long)l * perimeter / count);
+    Coord a;
+    if (p < board.width - 1) a = {p, 0};
+    else if ((p -= board.width - 1) < board.height - 1) a = {board.width - 1, p};
+    else if ((p -= board.height - 1) < board.width - 1) a = {board.width - 1 - p, board.height - 1};
+    else a = {0, board.height - 1 - (p - (board.width - 1))};
+
+    // Search square rings of growing radius for a free cell
+    Coord found = {-1, -1};
+    int reach = board.width > board.height ? board.width : board.height;
+    for (int r=0; r<reach && found.x == -1; r++) {
+      for (int dy=-r; dy<=r && found.x == -1; dy++) {
+        for (int dx=-r; dx<=r; dx++) {
+          if (dx != -r && dx != r && dy != -r && dy != r) continue;
+          Coord b = {a.x + dx, a.y + dy};
+          if (board.isFree(b)) {
+            found = b;
+            break;
+          }
+        }
+      }
+    }
+    if (found.x == -1) break;
+
+    bool known = false;
+    for (int i=0; i<(int)landmarks.size(); i++) {
+      if (landmarks[i].x == found.x && landmarks[i].y == found.y) known = true;
+    }
+    if (!known) landmarks.push_back(found);
+  }
+}
+
+// Dijkstra search from a cell, a move costs the terrain it enters
+void LandmarkTable::explore(Coord from, std::vector<unsigned int>& dist, OpenSet& openSet) {
+  dist.assign(board.width*board.height, UNREACHABLE);
+  openSet.clear();
+  dist[board.index(from)] = 0;
+  openSet.push(board.index(from), 0, 0);
+  while (!openSet.empty()) {
+    int id = openSet.pop();
+    Coord cur = board.coord(id);
+    Coord next[4] = {{cur.x - 1, cur.y}, {cur.x + 1, cur.y}, {cur.x, cur.y - 1}, {cur.x, cur.y + 1}};
+    for (int i=0; i<4; i++) {
+      if (!board.isFree(next[i])) continue;
+      int nb = board.index(next[i]);
+      unsigned int d = dist[id] + board.cell(next[i]).cost;
+      if (d >= dist[nb]) continue;
+      if (dist[nb] == UNREACHABLE) openSet.push(nb, (int)d, 0);
+      else openSet.decrease(nb, (int)d, 0);
+      dist[nb] = d;
+    }
+  }
+}
+
+// Distance from landmark l to a cell, UNREACHABLE if there is no path
+unsigned int LandmarkTable::distance(int id, int l) const {
+  size_t i = (size_t)id*landmarks.size() + l;
+  if (!narrow.empty()) return narrow[i] == 65535 ? UNREACHABLE : narrow[i];
+  return wide[i];
+}
+
+// Memory taken by the distances
+size_t LandmarkTable::bytes() const {
+  return narrow.size()*sizeof(unsigned short) + wide.size()*sizeof(unsigned int);
+}
+
+// Constructor
+ALTAStar::ALTAStar(const Board& board, LandmarkTable& table) : AStar(board), table(table) {
+}
+
+// Rebuild the table if the board changed, look up the landmarks to END, then search
+void ALTAStar::init(Coord start, Coord end) {
+  table.refresh();
+  this->end = end;
+  target.resize(table.landmarks.size());
+  for (int l=0; l<(int)target.size(); l++) {
+    target[l] = table.distance(board.index(end), l);
+  }
+  AStar::init(start, end);
+}
+
+int ALTAStar::estimate(Coord a) {
+  int best = AStar::estimate(a);
+  int id = board.index(a);
+  for (int l=0; l<(int)target.size(); l++) {
+    unsigned int d = table.distance(id, l);
+    if (target[l] == UNREACHABLE || d == UNREACHABLE || target[l] <= d) continue;
+    if ((int)(target[l] - d) > best) best = (int)(target[l] - d);
+  }
+  return best;
+}
@@ -0,0 +1,45 @@
+#ifndef __LANDMARKS_HPP__
+#define __LANDMARKS_HPP__
+
+#include <vector>
+#include "astar.hpp"
+
+// Distances from a few landmark cells to every cell, precomputed for ALT
+// The landmarks are spread along the border of the board, and each one gets
+// a Dijkstra search with the terrain costs, run in parallel
+// Distances are stored per cell, 16 bits each when they all fit, else 32
+class LandmarkTable {
+public:
+  const Board& board;
+  int count;   // Landmarks asked for
+  int threads; // Threads building the table
+  std::vector<Coord> landmarks;
+  std::vector<unsigned short> narrow; // landmarks.size() distances per cell, 65535 if unreachable
+  std::vector<unsigned int> wide;     // Used instead when a distance does not fit in narrow
+  bool dirty;
+  double buildTime; // Seconds taken by the last build
+
+  LandmarkTable(const Board& board, int count = 8, int threads = 0);
+  void update(Coord a);
+  void refresh();
+  void build();
+  void select();
+  void explore(Coord from, std::vector<unsigned int>& dist, OpenSet& openSet);
+  unsigned int distance(int id, int l) const;
+  size_t bytes() const;
+};
+
+// A* with the ALT heuristic: by the triangle inequality, the distance from a
+// to END is at least d(L, END) - d(L, a) for every landmark L, and the best
+// of these bounds is taken, never below the scaled Manhattan distance
+class ALTAStar : public AStar {
+public:
+  LandmarkTable& table;
+  std::vector<unsigned int> target; // Distance from each landmark to END
+
+  ALTAStar(const Board& board, LandmarkTable& table);
+  void init(Coord start, Coord end);
+  int estimate(Coord a);
+};
+
+#endif
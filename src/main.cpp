@@ -1,292 +1,116 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <vector>
 #include "shader.hpp"
+#include "board.hpp"
+#include "astar.hpp"
+#include "jps.hpp"
+#include "jpsplus.hpp"
+#include "bidirectional.hpp"
+#include "hpa.hpp"
+#include "dstarlite.hpp"
+#include "pathcache.hpp"
+#include "gridastar.hpp"
+#include "landmarks.hpp"
+#include "components.hpp"
+#include "bitbfs.hpp"
+#include "flowfield.hpp"
+#include "thetastar.hpp"
+#include "arastar.hpp"
+#include "view.hpp"
+
+#define DEFAULT_BOARD_SIZE 16
 
-#define SCREEN_WIDTH 800
-#define SCREEN_HEIGHT 800
-#define BOARD_SIZE 16
+// Callback function for when the window is resized
+void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
+  glViewport(0, 0, width, height);
+}
 
-typedef struct Coord {
+int main(int argc, char* argv[]) {
   int x, y;
-} Coord;
-
-class Board {
-public:
-  // The status of a cell
-  typedef enum Status {
-    EMPTY, WALL, CHECKED, START, END, PATH
-  } Status;
-
-  // The progress of the A* algorithm
-  typedef enum Progress {
-    PREPARING, INITIALIZE, SOLVING, POST_SOLVE, FINISHED
-  } Progress;
-
-  typedef struct Cell {
-    int f, g, h;
-    Status status;
-    Coord parent;
-  } Cell;
-
-  Cell c[BOARD_SIZE][BOARD_SIZE];
-  Coord start, end;
-  Progress progress;
-  Coord openSet[BOARD_SIZE*BOARD_SIZE];
-  Coord closedSet[BOARD_SIZE*BOARD_SIZE];
-  int openCount, closedCount;
-  int margin;
-  float vertices[36*BOARD_SIZE*BOARD_SIZE];
-
-  // Suppose that the screen is a square, therefore the board is also a square
-  // This function converts the screen coordinates to OpenGL coordinates
-  float screenToOpenGL(int screenCoord, int screenSize) {
-    return (float)screenCoord / (float)screenSize * 2.0f - 1.0f;
-  }
-
-  // Manhattan distance between two coordinates
-  int heuristic(Coord a, Coord b) {
-    return abs(a.x-b.x) + abs(a.y-b.y);
-  }
-
-  // Sort an array of coordinates by fScore
-  void bubbleSort(Cell board[][BOARD_SIZE], Coord arr[], int n) {
-    for (int i=0; i<n-1; i++) {
-      for (int j=0; j<n-i-1; j++) {
-        if (board[arr[j].x][arr[j].y].f > board[arr[j+1].x][arr[j+1].y].f) {
-          Coord temp = arr[j];
-          arr[j] = arr[j+1];
-          arr[j+1] = temp;
-        }
-      }
-    }
-  }
 
-  // Remove the first element of an array of coordinates
-  void removeFirst(Coord arr[], int n) {
-    for (int i=0; i<n-1; i++) {
-      arr[i] = arr[i+1];
-    }
+  // The board size can be given as "astar <width> <height>"
+  int width = DEFAULT_BOARD_SIZE;
+  int height = DEFAULT_BOARD_SIZE;
+  if (argc >= 3) {
+    width = atoi(argv[1]);
+    height = atoi(argv[2]);
   }
-
-  // Check if a coordinate is in an array of coordinates
-  bool isIn(Coord arr[], int n, Coord c) {
-    for (int i=0; i<n; i++) {
-      if (arr[i].x == c.x && arr[i].y == c.y) {
-        return true;
-      }
-    }
-    return false;
+  if (width <= 0 || height <= 0) {
+    std::cout << "Invalid board size" << std::endl;
+    return -1;
   }
-
-  // Constructor
-  Board() {
-    // Initialize cells
-    for (int i=0; i<BOARD_SIZE; i++) {
-      for (int j=0; j<BOARD_SIZE; j++) {
-        // Assign values to INT_MAX
-        c[i][j].f = 2147483647;
-        c[i][j].g = 2147483647;
-        c[i][j].h = 2147483647;
-        c[i][j].status = EMPTY;
-      }
+  Board board(width, height);
+  View view(board);
+
+  // Solvers, cycled with the M key, each one built with its table the first
+  // time it is selected, so a large board only pays for the solvers it uses
+  const char* solverNames[] = {"A* (cached)", "A* (8-connected)", "A* (landmarks)", "JPS (4-connected)", "JPS (8-connected)", "JPS+ (8-connected)", "Bidirectional A*", "HPA*", "D* Lite", "BFS (bitboards)", "Flow field", "Theta*", "Lazy Theta*", "ARA*"};
+  int solverCount = 14;
+  // Solvers that count every move the same, whatever the terrain
+  bool ignoresTerrain[] = {false, false, false, true, true, true, false, true, true, true, false, true, true, false};
+  auto terrainNote = [&](int mode) {
+    if (ignoresTerrain[mode] && board.costCount[board.minCost()] != board.width*board.height) {
+      std::cout << "[INFO] " << solverNames[mode] << " ignores terrain costs" << std::endl;
     }
-
-    // Initialize start and end
-    start = {-1, -1};
-    end = {-1, -1};
-
-    // Initialize booleans
-    progress = PREPARING;
-
-    // Initialize open and closed sets
-    openCount = 0;
-    closedCount = 0;
-
-    // Initialize vertices and colors of the board
-    margin = 2;
-    for (int i=0; i<BOARD_SIZE; i++) {
-      for (int j=0; j<BOARD_SIZE; j++) {
-        vertices[36*(i*BOARD_SIZE+j)+ 0] = screenToOpenGL(SCREEN_WIDTH*i/BOARD_SIZE+margin, SCREEN_WIDTH); // Bottom-left
-        vertices[36*(i*BOARD_SIZE+j)+ 1] = screenToOpenGL(SCREEN_HEIGHT*j/BOARD_SIZE+margin, SCREEN_HEIGHT); // TODO - Check if this is correct
-        vertices[36*(i*BOARD_SIZE+j)+ 2] = 0.0f;
-        vertices[36*(i*BOARD_SIZE+j)+ 3] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+ 4] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+ 5] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+ 6] = screenToOpenGL(SCREEN_WIDTH*(i+1)/BOARD_SIZE-margin, SCREEN_WIDTH); // Bottom-right
-        vertices[36*(i*BOARD_SIZE+j)+ 7] = screenToOpenGL(SCREEN_HEIGHT*j/BOARD_SIZE+margin, SCREEN_HEIGHT);
-        vertices[36*(i*BOARD_SIZE+j)+ 8] = 0.0f;
-        vertices[36*(i*BOARD_SIZE+j)+ 9] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+10] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+11] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+12] = screenToOpenGL(SCREEN_WIDTH*(i+1)/BOARD_SIZE-margin, SCREEN_WIDTH); // Top-right
-        vertices[36*(i*BOARD_SIZE+j)+13] = screenToOpenGL(SCREEN_HEIGHT*(j+1)/BOARD_SIZE-margin, SCREEN_HEIGHT);
-        vertices[36*(i*BOARD_SIZE+j)+14] = 0.0f;
-        vertices[36*(i*BOARD_SIZE+j)+15] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+16] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+17] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+18] = screenToOpenGL(SCREEN_WIDTH*i/BOARD_SIZE+margin, SCREEN_WIDTH); // Bottom-left
-        vertices[36*(i*BOARD_SIZE+j)+19] = screenToOpenGL(SCREEN_HEIGHT*j/BOARD_SIZE+margin, SCREEN_HEIGHT);
-        vertices[36*(i*BOARD_SIZE+j)+20] = 0.0f;
-        vertices[36*(i*BOARD_SIZE+j)+21] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+22] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+23] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+24] = screenToOpenGL(SCREEN_WIDTH*i/BOARD_SIZE+margin, SCREEN_WIDTH); // Top-left
-        vertices[36*(i*BOARD_SIZE+j)+25] = screenToOpenGL(SCREEN_HEIGHT*(j+1)/BOARD_SIZE-margin, SCREEN_HEIGHT);
-        vertices[36*(i*BOARD_SIZE+j)+26] = 0.0f;
-        vertices[36*(i*BOARD_SIZE+j)+27] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+28] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+29] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+30] = screenToOpenGL(SCREEN_WIDTH*(i+1)/BOARD_SIZE-margin, SCREEN_WIDTH); // Top-right
-        vertices[36*(i*BOARD_SIZE+j)+31] = screenToOpenGL(SCREEN_HEIGHT*(j+1)/BOARD_SIZE-margin, SCREEN_HEIGHT);
-        vertices[36*(i*BOARD_SIZE+j)+32] = 0.0f;
-        vertices[36*(i*BOARD_SIZE+j)+33] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+34] = 1.0f;
-        vertices[36*(i*BOARD_SIZE+j)+35] = 1.0f;
-      }
+  };
+  std::unique_ptr<JumpTable> jumpTable;
+  std::unique_ptr<HPA> hpa;
+  std::unique_ptr<LandmarkTable> landmarkTable;
+  std::unique_ptr<AStar> solvers[14]; // Declared after the tables they refer to
+  CornerRule corners = CUT_NEVER;
+  const char* cornerNames[] = {"never", "if one side is free", "always"};
+  auto create = [&](int mode) -> AStar* {
+    switch (mode) {
+      case 0: return new PathCache(board); // A* that answers repeated queries from its cache
+      case 1: return new GridAStar<8>(board, corners);
+      case 2:
+        landmarkTable.reset(new LandmarkTable(board));
+        return new ALTAStar(board, *landmarkTable);
+      case 3: return new JPS(board, JPS::FOUR);
+      case 4: return new JPS(board, JPS::EIGHT);
+      case 5:
+        jumpTable.reset(new JumpTable(board));
+        return new JPSPlus(board, *jumpTable);
+      case 6: return new BidirectionalAStar(board);
+      case 7:
+        hpa.reset(new HPA(board));
+        return new HPAStar(board, *hpa);
+      case 8: return new DStarLite(board);
+      case 9: return new BitBFS(board);
+      case 10: return new FlowField(board);
+      case 11: return new ThetaStar(board);
+      case 12: return new ThetaStar(board, true);
+      default: return new ARAStar(board);
     }
   };
-
-  // Change color of cell a
-  void changeColor(Coord a, Status s) {
-    switch(s) {
-      case EMPTY: // White
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 3] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 4] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 5] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 9] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+10] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+11] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+15] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+16] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+17] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+21] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+22] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+23] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+27] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+28] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+29] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+33] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+34] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+35] = 1.0f;
-        break;
-      
-      case WALL: // Black
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 3] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 4] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 5] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 9] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+10] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+11] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+15] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+16] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+17] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+21] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+22] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+23] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+27] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+28] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+29] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+33] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+34] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+35] = 0.0f;
-        break;
-      
-      case CHECKED: // Green
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 3] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 4] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 5] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 9] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+10] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+11] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+15] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+16] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+17] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+21] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+22] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+23] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+27] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+28] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+29] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+33] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+34] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+35] = 0.0f;
-        break;
-      
-      case START: // Red
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 3] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 4] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 5] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 9] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+10] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+11] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+15] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+16] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+17] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+21] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+22] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+23] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+27] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+28] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+29] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+33] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+34] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+35] = 0.0f;
-        break;
-
-      case END: // Blue
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 3] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 4] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 5] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 9] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+10] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+11] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+15] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+16] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+17] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+21] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+22] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+23] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+27] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+28] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+29] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+33] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+34] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+35] = 1.0f;
-        break;
-
-      case PATH: // Rainbow
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 3] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 4] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 5] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+ 9] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+10] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+11] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+15] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+16] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+17] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+21] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+22] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+23] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+27] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+28] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+29] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+33] = 1.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+34] = 0.0f;
-        vertices[36*(a.x*BOARD_SIZE+a.y)+35] = 1.0f;
-        break;
+  int mode = 0;
+  solvers[mode].reset(create(mode));
+  AStar* solver = solvers[mode].get();
+  ComponentIndex components(board); // Answers unreachable queries without a search
+  // Invalidate what was precomputed from the walls after a cell was toggled
+  auto wallChanged = [&](Coord a) {
+    if (jumpTable) jumpTable->update(a);
+    if (hpa) hpa->update(a);
+    if (landmarkTable) landmarkTable->update(a);
+    components.update(a);
+    for (int i=0; i<solverCount; i++) {
+      if (solvers[i]) solvers[i]->update(a);
     }
   };
-};
-
-// Callback function for when the window is resized
-void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-  glViewport(0, 0, width, height);
-}
-
-int main(void) {
-  int x, y;
-  Board board;
+  int shown = 0; // Cells of the search already colored
+  // Work per frame while solving, cycled with the B key: a number of steps,
+  // a time in seconds, or neither to solve to completion in one frame
+  int budgetSteps[] = {1, 100, 10000, 0, 0};
+  double budgetSeconds[] = {0, 0, 0, 0.008, 0};
+  const char* budgetNames[] = {"1 step", "100 steps", "10000 steps", "8 ms", "to completion"};
+  int budgetCount = 5;
+  int budget = 0;
+  std::vector<int> colored; // Cells colored by the last search
 
   // Initialize GLFW
   if (!glfwInit()) {
@@ -326,7 +150,8 @@ int main(void) {
   glGenBuffers(1, &VBO);
   glBindVertexArray(VAO);
   glBindBuffer(GL_ARRAY_BUFFER, VBO);
-  glBufferData(GL_ARRAY_BUFFER, sizeof(board.vertices), board.vertices, GL_STATIC_DRAW);
+  glBufferData(GL_ARRAY_BUFFER, view.vertices.size()*sizeof(float), view.vertices.data(), GL_DYNAMIC_DRAW);
+  view.clean();
 
   // Set vertex attributes
   // Position attribute
@@ -350,6 +175,14 @@ int main(void) {
   int sNow = GLFW_RELEASE;
   int ePre = GLFW_RELEASE;
   int eNow = GLFW_RELEASE;
+  int mPre = GLFW_RELEASE;
+  int mNow = GLFW_RELEASE;
+  int cPre = GLFW_RELEASE;
+  int cNow = GLFW_RELEASE;
+  int tPre = GLFW_RELEASE;
+  int tNow = GLFW_RELEASE;
+  int bPre = GLFW_RELEASE;
+  int bNow = GLFW_RELEASE;
 
   // Main loop
   while (!glfwWindowShouldClose(window)) {
@@ -357,14 +190,15 @@ int main(void) {
     mouseNow = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT);
     if (mouseNow == GLFW_RELEASE && mousePre == GLFW_PRESS) {
       glfwGetCursorPos(window, &mouseX, &mouseY);
-      x = (int)(mouseX*BOARD_SIZE/SCREEN_WIDTH);
-      y = (int)((SCREEN_HEIGHT-mouseY)*BOARD_SIZE/SCREEN_HEIGHT);
+      x = (int)(mouseX*board.width/SCREEN_WIDTH);
+      y = (int)((SCREEN_HEIGHT-mouseY)*board.height/SCREEN_HEIGHT);
 
-      // Change the status of the clicked cell
-      if (board.c[x][y].status == Board::EMPTY) {
-        board.c[x][y].status = Board::WALL;
+      // Change the status of the clicked cell, a colored cell is still empty
+      Board::Status status = board.cell({x, y}).status;
+      if (status == Board::EMPTY || status == Board::CHECKED || status == Board::PATH) {
+        board.cell({x, y}).status = Board::WALL;
         board.progress = Board::PREPARING;
-        board.changeColor({x, y}, Board::WALL);
+        view.changeColor({x, y}, Board::WALL);
       } else {
         if (board.start.x == x && board.start.y == y) {
           board.start.x = -1;
@@ -373,11 +207,19 @@ int main(void) {
           board.end.x = -1;
           board.end.y = -1;
         }
-        board.c[x][y].status = Board::EMPTY;
+        board.cell({x, y}).status = Board::EMPTY;
         board.progress = Board::PREPARING;
-        board.changeColor({x, y}, Board::EMPTY);
+        view.changeColor({x, y}, Board::EMPTY);
+      }
+
+      // Invalidate what was precomputed from the walls, unless START or END
+      // was cleared, which leaves a free cell free
+      if (status != Board::START && status != Board::END) wallChanged({x, y});
+
+      // Replan right away if both ends are still set
+      if (!(board.start.x == -1 && board.start.y == -1) && !(board.end.x == -1 && board.end.y == -1)) {
+        board.progress = Board::INITIALIZE;
       }
-      glBufferData(GL_ARRAY_BUFFER, sizeof(board.vertices), board.vertices, GL_STATIC_DRAW);
     }
     mousePre = mouseNow;
 
@@ -388,123 +230,172 @@ int main(void) {
       glfwSetWindowShouldClose(window, GL_TRUE);
     } else if (sNow == GLFW_RELEASE && sPre == GLFW_PRESS) {
       glfwGetCursorPos(window, &mouseX, &mouseY);
-      x = (int)(mouseX*BOARD_SIZE/SCREEN_WIDTH);
-      y = (int)((SCREEN_HEIGHT-mouseY)*BOARD_SIZE/SCREEN_HEIGHT);
+      x = (int)(mouseX*board.width/SCREEN_WIDTH);
+      y = (int)((SCREEN_HEIGHT-mouseY)*board.height/SCREEN_HEIGHT);
       if (!(board.start.x == -1 && board.start.y == -1)) {
-        board.c[board.start.x][board.start.y].status = Board::EMPTY;
-        board.changeColor(board.start, Board::EMPTY);
+        board.cell(board.start).status = Board::EMPTY;
+        view.changeColor(board.start, Board::EMPTY);
       }
       board.start = {x, y};
-      board.c[x][y].status = Board::START;
+      Board::Status previous = board.cell({x, y}).status;
+      board.cell({x, y}).status = Board::START;
       board.progress = Board::PREPARING;
-      board.changeColor({x, y}, Board::START);
+      view.changeColor({x, y}, Board::START);
+      // Only a wall turned into the START cell changes the walls
+      if (previous == Board::WALL) wallChanged({x, y});
       if (!(board.end.x == -1 && board.end.y == -1)) {
         board.progress = Board::INITIALIZE;
       }
-      glBufferData(GL_ARRAY_BUFFER, sizeof(board.vertices), board.vertices, GL_STATIC_DRAW);
     } else if (eNow == GLFW_RELEASE && ePre == GLFW_PRESS) {
       glfwGetCursorPos(window, &mouseX, &mouseY);
-      x = (int)(mouseX*BOARD_SIZE/SCREEN_WIDTH);
-      y = (int)((SCREEN_HEIGHT-mouseY)*BOARD_SIZE/SCREEN_HEIGHT);
+      x = (int)(mouseX*board.width/SCREEN_WIDTH);
+      y = (int)((SCREEN_HEIGHT-mouseY)*board.height/SCREEN_HEIGHT);
       if (!(board.end.x == -1 && board.end.y == -1)) {
-        board.c[board.end.x][board.end.y].status = Board::EMPTY;
-        board.changeColor(board.end, Board::EMPTY);
+        board.cell(board.end).status = Board::EMPTY;
+        view.changeColor(board.end, Board::EMPTY);
       }
       board.end = {x, y};
-      board.c[x][y].status = Board::END;
+      Board::Status previous = board.cell({x, y}).status;
+      board.cell({x, y}).status = Board::END;
       board.progress = Board::PREPARING;
-      board.changeColor({x, y}, Board::END);
+      view.changeColor({x, y}, Board::END);
+      // Only a wall turned into the END cell changes the walls
+      if (previous == Board::WALL) wallChanged({x, y});
       if (!(board.start.x == -1 && board.start.y == -1)) {
         board.progress = Board::INITIALIZE;
       }
-      glBufferData(GL_ARRAY_BUFFER, sizeof(board.vertices), board.vertices, GL_STATIC_DRAW);
     }
     sPre = sNow;
     ePre = eNow;
 
+    // Switch to the next solver and solve again
+    mNow = glfwGetKey(window, GLFW_KEY_M);
+    if (mNow == GLFW_RELEASE && mPre == GLFW_PRESS) {
+      mode = (mode + 1) % solverCount;
+      if (!solvers[mode]) solvers[mode].reset(create(mode));
+      solver = solvers[mode].get();
+      std::cout << "[INFO] Solver: " << solverNames[mode] << std::endl;
+      terrainNote(mode);
+      if (!(board.start.x == -1 && board.start.y == -1) && !(board.end.x == -1 && board.end.y == -1)) {
+        board.progress = Board::INITIALIZE;
+      }
+    }
+    mPre = mNow;
+
+    // Switch the corner rule of the 8-connected A*
+    cNow = glfwGetKey(window, GLFW_KEY_C);
+    if (cNow == GLFW_RELEASE && cPre == GLFW_PRESS) {
+      corners = (CornerRule)((corners + 1) % 3);
+      if (solvers[1]) static_cast<GridAStar<8>*>(solvers[1].get())->corners = corners;
+      std::cout << "[INFO] Corner cutting: " << cornerNames[corners] << std::endl;
+      if (mode == 1 && !(board.start.x == -1 && board.start.y == -1) && !(board.end.x == -1 && board.end.y == -1)) {
+        board.progress = Board::INITIALIZE;
+      }
+    }
+    cPre = cNow;
+
+    // Cycle the terrain cost of the cell under the cursor through 1, 2, 4 and 8
+    tNow = glfwGetKey(window, GLFW_KEY_T);
+    if (tNow == GLFW_RELEASE && tPre == GLFW_PRESS) {
+      glfwGetCursorPos(window, &mouseX, &mouseY);
+      x = (int)(mouseX*board.width/SCREEN_WIDTH);
+      y = (int)((SCREEN_HEIGHT-mouseY)*board.height/SCREEN_HEIGHT);
+      // The cursor can be outside the window when the key is released
+      if (board.inside({x, y})) {
+        int cost = board.cell({x, y}).cost;
+        board.setCost({x, y}, cost >= 8 ? 1 : cost*2);
+        if (board.cell({x, y}).status == Board::EMPTY) view.changeColor({x, y}, Board::EMPTY);
+        terrainNote(mode);
+        if (landmarkTable) landmarkTable->update({x, y});
+        for (int i=0; i<solverCount; i++) {
+          if (solvers[i]) solvers[i]->update({x, y});
+        }
+        if (!(board.start.x == -1 && board.start.y == -1) && !(board.end.x == -1 && board.end.y == -1)) {
+          board.progress = Board::INITIALIZE;
+        }
+      }
+    }
+    tPre = tNow;
+
+    // Cycle the work done per frame while solving
+    bNow = glfwGetKey(window, GLFW_KEY_B);
+    if (bNow == GLFW_RELEASE && bPre == GLFW_PRESS) {
+      budget = (budget + 1) % budgetCount;
+      std::cout << "[INFO] Budget per frame: " << budgetNames[budget] << std::endl;
+    }
+    bPre = bNow;
+
     // Initialize A* algorithm
     if (board.progress == Board::INITIALIZE) {
-      // Reset the colors of the board
-      for (int i=0; i<BOARD_SIZE; i++) {
-        for (int j=0; j<BOARD_SIZE; j++) {
-          if (board.c[i][j].status == Board::PATH) {
-            board.c[i][j].status = Board::EMPTY;
-            board.changeColor({i, j}, Board::EMPTY);
-          }
+      // Reset the colors left by the previous search, only touching the cells it colored
+      for (int i=0; i<(int)colored.size(); i++) {
+        Coord a = board.coord(colored[i]);
+        if (board.cell(a).status == Board::CHECKED || board.cell(a).status == Board::PATH) {
+          board.cell(a).status = Board::EMPTY;
+          view.changeColor(a, Board::EMPTY);
         }
       }
+      colored.clear();
 
-      // Initialize the open set
-      board.openSet[board.openCount++] = board.start;
-      board.c[board.start.x][board.start.y].g = 0;
-      board.c[board.start.x][board.start.y].h = board.heuristic(board.start, board.end);
-      board.c[board.start.x][board.start.y].f = board.c[board.start.x][board.start.y].g + board.c[board.start.x][board.start.y].h;
-      board.c[board.start.x][board.start.y].parent = {-1, -1};
-      board.progress = Board::SOLVING;
-      glBufferData(GL_ARRAY_BUFFER, sizeof(board.vertices), board.vertices, GL_STATIC_DRAW);
+      // Both ends in different components, there is nothing to search
+      if (!components.connected(board.start, board.end)) {
+        std::cout << "No solution" << std::endl;
+        board.progress = Board::FINISHED;
+      } else {
+        solver->init(board.start, board.end);
+        shown = 0;
+        board.progress = Board::SOLVING;
+      }
     }
 
     // Solve the maze
     if (board.progress == Board::SOLVING) {
-      // If the open set is empty, there is no solution
-      if (board.openCount <= 0) {
-        std::cout << "No solution" << std::endl;
-        return 0;
+      // Step until the budget of the frame is spent, the clock is only read every 16 steps
+      auto frameStart = std::chrono::steady_clock::now();
+      AStar::State state;
+      int steps = 0;
+      do {
+        state = solver->step();
+        steps++;
+        if (budgetSteps[budget] > 0 && steps >= budgetSteps[budget]) break;
+        if (budgetSeconds[budget] > 0 && steps % 16 == 0 &&
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - frameStart).count() >= budgetSeconds[budget]) break;
+      } while (state == AStar::SEARCHING);
+
+      // Color the cells that entered the open set
+      for (; shown < (int)solver->generated.size(); shown++) {
+        Coord a = board.coord(solver->generated[shown]);
+        if (board.cell(a).status == Board::START || board.cell(a).status == Board::END) continue;
+        board.cell(a).status = Board::CHECKED;
+        view.changeColor(a, Board::CHECKED);
+        colored.push_back(solver->generated[shown]);
       }
 
-      // Sort the open set by fScore
-      board.bubbleSort(board.c, board.openSet, board.openCount);
-
-      // The current cell is the one with the lowest fScore
-      Coord cur = board.openSet[0];
-      board.removeFirst(board.openSet, board.openCount--);
-      board.closedSet[board.closedCount++] = cur;
-
-      // Define a lambda function for processing neighbors
-      auto processNeighbor = [&](Coord neighbor) {
-        if (!board.isIn(board.closedSet, board.closedCount, neighbor) && board.c[neighbor.x][neighbor.y].status != Board::WALL) {
-          int tentative_gScore = board.c[cur.x][cur.y].g + 1;
-          int hScore = board.heuristic(neighbor, board.end);
-          int fScore = tentative_gScore + hScore;
-
-          if (!board.isIn(board.openSet, board.openCount, neighbor) || fScore < board.c[neighbor.x][neighbor.y].f) {
-            board.c[neighbor.x][neighbor.y].g = tentative_gScore;
-            board.c[neighbor.x][neighbor.y].h = hScore;
-            board.c[neighbor.x][neighbor.y].f = fScore;
-            board.c[neighbor.x][neighbor.y].parent = cur;
-
-            if (!board.isIn(board.openSet, board.openCount, neighbor)) {
-              board.openSet[board.openCount++] = neighbor;
-              board.c[neighbor.x][neighbor.y].status = Board::CHECKED;
-              board.changeColor(neighbor, Board::CHECKED);
-            }
-          }
-        }
-      };
-
-      // Check left, right, top, and bottom neighbors
-      if (cur.x > 0) processNeighbor({cur.x - 1, cur.y});
-      if (cur.x < BOARD_SIZE - 1) processNeighbor({cur.x + 1, cur.y});
-      if (cur.y > 0) processNeighbor({cur.x, cur.y - 1});
-      if (cur.y < BOARD_SIZE - 1) processNeighbor({cur.x, cur.y + 1});
-
-      // Check if the END cell is in the closedSet
-      if (board.isIn(board.closedSet, board.closedCount, board.end)) {
+      // If the open set is empty, there is no solution, wait for the next edit
+      if (state == AStar::NO_PATH) {
+        std::cout << "No solution" << std::endl;
+        board.progress = Board::FINISHED;
+      }
+      if (state == AStar::FOUND) {
         board.progress = Board::POST_SOLVE;
       }
-
-      glBufferData(GL_ARRAY_BUFFER, sizeof(board.vertices), board.vertices, GL_STATIC_DRAW);
     }
 
     // Post-solve
     if (board.progress == Board::POST_SOLVE) {
-      Coord cur = board.end;
-      while (!(cur.x == board.start.x && cur.y == board.start.y)) {
-        board.changeColor(cur, Board::PATH);
-        cur = board.c[cur.x][cur.y].parent;
+      std::vector<Coord> path = solver->path();
+      for (int i=1; i<(int)path.size(); i++) {
+        if (board.cell(path[i]).status != Board::END) board.cell(path[i]).status = Board::PATH;
+        view.changeColor(path[i], Board::PATH);
+        colored.push_back(board.index(path[i]));
       }
       board.progress = Board::FINISHED;
-      glBufferData(GL_ARRAY_BUFFER, sizeof(board.vertices), board.vertices, GL_STATIC_DRAW);
+    }
+
+    // Upload the quads changed this frame, in one call
+    if (view.low <= view.high) {
+      glBufferSubData(GL_ARRAY_BUFFER, 36*view.low*sizeof(float), 36*(view.high - view.low + 1)*sizeof(float), &view.vertices[36*view.low]);
+      view.clean();
     }
 
     // Clear the screen
@@ -512,7 +403,7 @@ int main(void) {
 
     // Draw the board
     glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6*BOARD_SIZE*BOARD_SIZE);
+    glDrawArrays(GL_TRIANGLES, 0, 6*board.width*board.height);
 
     // Swap buffers
     glfwSwapBuffers(window);
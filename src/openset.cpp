@@ -0,0 +1,117 @@
+#include "openset.hpp"
+
+// Constructor
+OpenSet::OpenSet(int capacity) {
+  heap.reserve(capacity);
+  pos.assign(capacity, 0);
+}
+
+bool OpenSet::empty() {
+  return heap.empty();
+}
+
+int OpenSet::size() {
+  return (int)heap.size();
+}
+
+// A position is only trusted if the heap entry there points back to the cell
+bool OpenSet::contains(int id) {
+  return pos[id] < (int)heap.size() && heap[pos[id]].id == id;
+}
+
+// Cell with the lowest fScore
+const OpenSet::Node& OpenSet::top() {
+  return heap[0];
+}
+
+// Insert a cell with the given fScore, ties are broken by the lower hScore
+void OpenSet::push(int id, int f, int h) {
+  heap.push_back({f, h, id});
+  pos[id] = (int)heap.size() - 1;
+  siftUp((int)heap.size() - 1);
+}
+
+// Remove and return the cell with the lowest fScore
+int OpenSet::pop() {
+  int id = heap[0].id;
+  swap(0, (int)heap.size() - 1);
+  heap.pop_back();
+  if (!heap.empty()) siftDown(0);
+  return id;
+}
+
+// Lower the fScore of a cell already in the heap
+void OpenSet::decrease(int id, int f, int h) {
+  int i = pos[id];
+  heap[i].f = f;
+  heap[i].h = h;
+  siftUp(i);
+}
+
+// Change the fScore of a cell already in the heap, in either direction
+void OpenSet::update(int id, int f, int h) {
+  int i = pos[id];
+  heap[i].f = f;
+  heap[i].h = h;
+  siftUp(i);
+  siftDown(pos[id]);
+}
+
+// Take a cell out of the heap, wherever it is
+void OpenSet::remove(int id) {
+  int i = pos[id];
+  int last = (int)heap.size() - 1;
+  swap(i, last);
+  heap.pop_back();
+  if (i < last) {
+    int moved = heap[i].id;
+    siftUp(i);
+    siftDown(pos[moved]);
+  }
+}
+
+// Remove every cell in O(1), stale positions are rejected by contains
+void OpenSet::clear() {
+  heap.clear();
+}
+
+// Make room for ids up to capacity, for searches whose states are not cells
+void OpenSet::reserve(int capacity) {
+  if (capacity > (int)pos.size()) pos.resize(capacity, 0);
+}
+
+bool OpenSet::less(int a, int b) {
+  if (heap[a].f != heap[b].f) return heap[a].f < heap[b].f;
+  return heap[a].h < heap[b].h;
+}
+
+void OpenSet::swap(int a, int b) {
+  Node temp = heap[a];
+  heap[a] = heap[b];
+  heap[b] = temp;
+  pos[heap[a].id] = a;
+  pos[heap[b].id] = b;
+}
+
+void OpenSet::siftUp(int i) {
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    if (!less(i, parent)) break;
+    swap(i, parent);
+    i = parent;
+  }
+}
+
+void OpenSet::siftDown(int i) {
+  int n = (int)heap.size();
+  while (true) {
+    int l = 2 * i + 1;
+    int r = l + 1;
+    int m = i;
+    if (l < n && less(l, m)) m = l;
+    if (r < n && less(r, m)) m = r;
+    if (m == i) break;
+    swap(i, m);
+    i = m;
+  }
+}
@@ -0,0 +1,36 @@
+#ifndef __OPENSET_HPP__
+#define __OPENSET_HPP__
+
+#include <vector>
+
+// Open set of the A* algorithm as an indexed binary heap ordered by fScore
+// Every cell remembers its position in the heap, so a better path is a decrease-key
+class OpenSet {
+public:
+  typedef struct Node {
+    int f, h, id;
+  } Node;
+
+  std::vector<Node> heap;
+  std::vector<int> pos; // Position of each cell in the heap, stale for absent cells
+
+  OpenSet(int capacity);
+  bool empty();
+  int size();
+  bool contains(int id);
+  const Node& top();
+  void push(int id, int f, int h);
+  int pop();
+  void decrease(int id, int f, int h);
+  void update(int id, int f, int h);
+  void remove(int id);
+  void clear();
+  void reserve(int capacity);
+
+  bool less(int a, int b);
+  void swap(int a, int b);
+  void siftUp(int i);
+  void siftDown(int i);
+};
+
+#endif
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include "pathcache.hpp"
+
+// Toggled cells kept before every entry is brought to the current version
+#define EDIT_LOG_SIZE 1024
+
+// Constructor
+PathCache::PathCache(const Board& board, int capacity) : AStar(board), capacity(capacity) {
+  base = 0;
+  version = 0;
+  hit = false;
+  hits = 0;
+  misses = 0;
+}
+
+// Answer from the cache if the entry is still valid, else start a search
+void PathCache::init(Coord start, Coord end) {
+  std::unordered_map<long long, std::list<Entry>::iterator>::iterator it = lookup.find(key(start, end));
+  if (it != lookup.end()) {
+    if (valid(*it->second)) {
+      entries.splice(entries.begin(), entries, it->second);
+      this->start = start;
+      this->end = end;
+      cached = it->second->path;
+      generated.clear();
+      expanded = 0;
+      hit = true;
+      hits++;
+      state = cached.empty() ? NO_PATH : FOUND;
+      return;
+    }
+    entries.erase(it->second);
+    lookup.erase(it);
+  }
+  hit = false;
+  misses++;
+  AStar::init(start, end);
+}
+
+// Search step, the result is stored once the search is over
+AStar::State PathCache::step() {
+  if (hit || state != SEARCHING) return state;
+  if (AStar::step() != SEARCHING) store();
+  return state;
+}
+
+std::vector<Coord> PathCache::path() {
+  if (!hit) return AStar::path();
+  if (state != FOUND) return std::vector<Coord>();
+  return cached;
+}
+
+// Record a toggled cell, entries are checked against it when looked up
+void PathCache::update(Coord a) {
+  edits.push_back(a);
+  version++;
+  if ((int)edits.size() < EDIT_LOG_SIZE) return;
+
+  // Bring every entry to the current version so the log can be dropped
+  for (std::list<Entry>::iterator it = entries.begin(); it != entries.end();) {
+    if (valid(*it)) {
+      ++it;
+    } else {
+      lookup.erase(key(it->start, it->end));
+      it = entries.erase(it);
+    }
+  }
+  base = version;
+  edits.clear();
+}
+
+long long PathCache::key(Coord start, Coord end) const {
+  return (long long)board.index(start) * board.width * board.height + board.index(end);
+}
+
+// Check the cells toggled since the entry was stored or last checked
+bool PathCache::valid(Entry& e) {
+  if (board.minCost() < e.minCost) return false;
+  for (unsigned int v = e.version; v < version; v++) {
+    if (touches(e, edits[v - base])) return false;
+  }
+  e.version = version;
+  return true;
+}
+
+bool PathCache::touches(const Entry& e, Coord a) const {
+  if (std::binary_search(e.cells.begin(), e.cells.end(), board.index(a))) return true;
+  if (board.isWall(a)) return false;
+  Coord next[4] = {{a.x - 1, a.y}, {a.x + 1, a.y}, {a.x, a.y - 1}, {a.x, a.y + 1}};
+  for (int i=0; i<4; i++) {
+    if (board.inside(next[i]) && std::binary_search(e.expanded.begin(), e.expanded.end(), board.index(next[i]))) return true;
+  }
+  return false;
+}
+
+// Store the result of the search just finished, dropping the oldest entry if full
+void PathCache::store() {
+  Entry e;
+  e.start = start;
+  e.end = end;
+  e.path = AStar::path();
+  for (int i=0; i<(int)e.path.size(); i++) {
+    e.cells.push_back(board.index(e.path[i]));
+  }
+  for (int i=0; i<(int)generated.size(); i++) {
+    if (n[generated[i]].set & IN_CLOSED) e.expanded.push_back(generated[i]);
+  }
+  std::sort(e.cells.begin(), e.cells.end());
+  std::sort(e.expanded.begin(), e.expanded.end());
+  e.version = version;
+  e.minCost = board.minCost();
+
+  entries.push_front(e);
+  lookup[key(start, end)] = entries.begin();
+  if ((int)entries.size() > capacity) {
+    lookup.erase(key(entries.back().start, entries.back().end));
+    entries.pop_back();
+  }
+}
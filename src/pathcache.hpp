@@ -0,0 +1,49 @@
+#ifndef __PATHCACHE_HPP__
+#define __PATHCACHE_HPP__
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "astar.hpp"
+
+// A* search that remembers its last results, least recently used first out
+// An entry is valid for a version of the map, and every toggled cell bumps
+// the version; entries are checked against the toggled cells on lookup
+// A new wall only matters if it is on the path, and a freed cell only if it
+// borders a cell the search expanded, as every cheaper path would have to
+// leave the expanded region through it
+// That only holds for the heuristic the search used, so an entry is dropped
+// once the cheapest terrain is below the one it was searched with
+class PathCache : public AStar {
+public:
+  typedef struct Entry {
+    Coord start, end;
+    std::vector<Coord> path;
+    std::vector<int> cells;    // Path cells, sorted
+    std::vector<int> expanded; // Cells expanded by the search, sorted
+    unsigned int version;      // Map version the entry is valid for
+    int minCost;               // Cheapest terrain when it was searched
+  } Entry;
+
+  int capacity;
+  std::list<Entry> entries; // Most recently used first
+  std::unordered_map<long long, std::list<Entry>::iterator> lookup;
+  std::vector<Coord> edits; // Toggled cells, the first one made version base+1
+  unsigned int base, version;
+  bool hit; // The current search was answered from the cache
+  std::vector<Coord> cached;
+  int hits, misses;
+
+  PathCache(const Board& board, int capacity = 64);
+  void init(Coord start, Coord end);
+  State step();
+  std::vector<Coord> path();
+  void update(Coord a);
+
+  long long key(Coord start, Coord end) const;
+  bool valid(Entry& e);
+  bool touches(const Entry& e, Coord a) const;
+  void store();
+};
+
+#endif
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include "spacetime.hpp"
+
+// Directions to the 4 neighbors, then waiting in place
+static const int DX[5] = {-1, 1, 0, 0, 0};
+static const int DY[5] = {0, 0, -1, 1, 0};
+
+// Constructor
+ConstraintTable::ConstraintTable(const Board& board) : board(board) {
+  horizon = 0;
+}
+
+void ConstraintTable::clear() {
+  vertices.clear();
+  edges.clear();
+  latest.clear();
+  horizon = 0;
+}
+
+// Forbid being on a at time t
+void ConstraintTable::addVertex(Coord a, int t) {
+  int id = board.index(a);
+  vertices.insert((long long)t*board.width*board.height + id);
+  std::unordered_map<int, int>::iterator it = latest.find(id);
+  if (it == latest.end() || it->second < t) latest[id] = t;
+  if (t > horizon) horizon = t;
+}
+
+// Forbid the move from a to its neighbor b arriving at time t
+void ConstraintTable::addEdge(Coord a, Coord b, int t) {
+  int k = b.x < a.x ? 0 : b.x > a.x ? 1 : b.y < a.y ? 2 : 3;
+  edges.insert(((long long)t*board.width*board.height + board.index(a))*4 + k);
+  if (t > horizon) horizon = t;
+}
+
+bool ConstraintTable::blocked(Coord a, int t) const {
+  return vertices.count((long long)t*board.width*board.height + board.index(a)) > 0;
+}
+
+bool ConstraintTable::blockedEdge(Coord a, int k, int t) const {
+  return edges.count(((long long)t*board.width*board.height + board.index(a))*4 + k) > 0;
+}
+
+// Last time a is forbidden, -1 if never
+int ConstraintTable::last(Coord a) const {
+  std::unordered_map<int, int>::const_iterator it = latest.find(board.index(a));
+  return it == latest.end() ? -1 : it->second;
+}
+
+// Constructor
+SpaceTimeAStar::SpaceTimeAStar(const Board& board) : board(board), openSet(board.width*board.height) {
+  expanded = 0;
+  deadline = std::chrono::steady_clock::time_point::max();
+  timedOut = false;
+}
+
+// Cost from every cell to END, INT_MAX if unreachable: a Dijkstra search
+// from END that charges the cell it leaves, as the agent pays on entering
+void SpaceTimeAStar::distances(Coord end, std::vector<int>& toGoal) {
+  toGoal.assign(board.width*board.height, 2147483647);
+  if (!board.isFree(end)) return;
+  OpenSet queue(board.width*board.height);
+  toGoal[board.index(end)] = 0;
+  queue.push(board.index(end), 0, 0);
+  while (!queue.empty()) {
+    int id = queue.pop();
+    Coord cur = board.coord(id);
+    int d = toGoal[id] + board.cell(cur).cost;
+    for (int k=0; k<4; k++) {
+      Coord b = {cur.x + DX[k], cur.y + DY[k]};
+      if (!board.isFree(b) || d >= toGoal[board.index(b)]) continue;
+      if (toGoal[board.index(b)] == 2147483647) queue.push(board.index(b), d, 0);
+      else queue.decrease(board.index(b), d, 0);
+      toGoal[board.index(b)] = d;
+    }
+  }
+}
+
+// Path from start at time from to end avoiding the table, one cell per time
+// step, empty if there is none before the horizon or the deadline
+// The agent stays on END once there, so it only arrives after END is last
+// forbidden, unless a window cuts the path short
+std::vector<Coord> SpaceTimeAStar::findPath(Coord start, Coord end, const std::vector<int>& toGoal, const ConstraintTable& table,
+                                            int from, int window) {
+  nodes.clear();
+  states.clear();
+  openSet.clear();
+  expanded = 0;
+  timedOut = false;
+  if (!board.isFree(start) || toGoal[board.index(start)] == 2147483647 || table.blocked(start, from)) {
+    return std::vector<Coord>();
+  }
+
+  long long cells = board.width*board.height;
+  int limit = window > 0 ? from + window : table.horizon + (int)cells; // Past the last constraint, waiting never helps
+  int arrival = table.last(end);
+  nodes.push_back({board.index(start), from, 0, -1});
+  states[from*cells + board.index(start)] = 0;
+  openSet.push(0, toGoal[board.index(start)], toGoal[board.index(start)]);
+
+  while (!openSet.empty()) {
+    if ((expanded & 1023) == 1023 && std::chrono::steady_clock::now() > deadline) {
+      timedOut = true;
+      return std::vector<Coord>();
+    }
+    int n = openSet.pop();
+    Node cur = nodes[n];
+    Coord a = board.coord(cur.id);
+    expanded++;
+
+    if ((window == 0 && a.x == end.x && a.y == end.y && cur.t > arrival) || (window > 0 && cur.t == limit)) {
+      std::vector<Coord> result;
+      for (int i = n; i != -1; i = nodes[i].parent) {
+        result.push_back(board.coord(nodes[i].id));
+      }
+      std::reverse(result.begin(), result.end());
+      return result;
+    }
+    if (cur.t >= limit) continue;
+
+    for (int k=0; k<5; k++) {
+      Coord b = {a.x + DX[k], a.y + DY[k]};
+      int t = cur.t + 1;
+      if (!board.isFree(b) || table.blocked(b, t)) continue;
+      if (k < 4 && table.blockedEdge(a, k, t)) continue;
+      int g = cur.g + (k < 4 ? board.cell(b).cost : 1);
+      int h = toGoal[board.index(b)];
+      long long key = t*cells + board.index(b);
+
+      std::unordered_map<long long, int>::iterator it = states.find(key);
+      if (it == states.end()) {
+        int m = (int)nodes.size();
+        nodes.push_back({board.index(b), t, g, n});
+        states[key] = m;
+        openSet.reserve(m + 1);
+        openSet.push(m, g + h, h);
+      } else if (openSet.contains(it->second) && g < nodes[it->second].g) {
+        nodes[it->second].g = g;
+        nodes[it->second].parent = n;
+        openSet.decrease(it->second, g + h, h);
+      }
+    }
+  }
+  return std::vector<Coord>();
+}
+
+// Cost of a path, one wait costing 1
+int SpaceTimeAStar::cost(const std::vector<Coord>& path) const {
+  int total = 0;
+  for (int i=1; i<(int)path.size(); i++) {
+    if (path[i].x == path[i-1].x && path[i].y == path[i-1].y) total += 1;
+    else total += board.cell(path[i]).cost;
+  }
+  return total;
+}
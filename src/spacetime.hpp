@@ -0,0 +1,61 @@
+#ifndef __SPACETIME_HPP__
+#define __SPACETIME_HPP__
+
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "board.hpp"
+#include "openset.hpp"
+
+// Cells and moves an agent may not use at given times
+// A vertex entry forbids being on a cell at time t, an edge entry forbids
+// the move from a cell in direction k that arrives at time t
+class ConstraintTable {
+public:
+  const Board& board;
+  std::unordered_set<long long> vertices;
+  std::unordered_set<long long> edges;
+  std::unordered_map<int, int> latest; // Last forbidden time of each cell
+  int horizon; // Last forbidden time of any cell
+
+  ConstraintTable(const Board& board);
+  virtual ~ConstraintTable() {}
+  void clear();
+  void addVertex(Coord a, int t);
+  void addEdge(Coord a, Coord b, int t);
+  virtual bool blocked(Coord a, int t) const;
+  virtual bool blockedEdge(Coord a, int k, int t) const;
+  virtual int last(Coord a) const;
+};
+
+// A* over cells and time steps, for one agent among others: every step is a
+// move to a neighbor or a wait, and the states a ConstraintTable forbids are
+// skipped, so the agent may wait for a cell to clear instead of going around
+// A move costs the terrain it enters and a wait costs 1, and the heuristic is
+// the exact cost to END without the other agents, from a reverse Dijkstra
+// With a window, the search stops at the first state that many steps ahead,
+// wherever it is, and the agent may pass through END on the way
+class SpaceTimeAStar {
+public:
+  // Search state of a cell at a time step, parent being the previous state
+  typedef struct Node {
+    int id, t, g, parent;
+  } Node;
+
+  const Board& board;
+  std::vector<Node> nodes;
+  std::unordered_map<long long, int> states; // Node of each reached cell and time
+  OpenSet openSet; // Ordered by fScore, over the nodes
+  int expanded;
+  std::chrono::steady_clock::time_point deadline;
+  bool timedOut;
+
+  SpaceTimeAStar(const Board& board);
+  void distances(Coord end, std::vector<int>& toGoal);
+  std::vector<Coord> findPath(Coord start, Coord end, const std::vector<int>& toGoal, const ConstraintTable& table,
+                              int from = 0, int window = 0);
+  int cost(const std::vector<Coord>& path) const;
+};
+
+#endif
@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <cmath>
+#include "thetastar.hpp"
+
+// Neighbors, the 4 straight ones first
+static const int DX[8] = {-1, 1, 0, 0, -1, 1, -1, 1};
+static const int DY[8] = {0, 0, -1, 1, -1, -1, 1, 1};
+
+// Rounded down and up quotients, for any sign of a
+static long long floorDiv(long long a, long long b) {
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+static long long ceilDiv(long long a, long long b) {
+  return -floorDiv(-a, b);
+}
+
+// Constructor, the walls are packed once and kept current by update
+ThetaStar::ThetaStar(const Board& board, bool lazy) : AStar(board), lazy(lazy) {
+  words = (board.width + 63) / 64;
+  walls.assign((size_t)words*board.height, 0);
+  sightChecks = 0;
+  for (int y=0; y<board.height; y++) {
+    for (int x=0; x<board.width; x++) {
+      update({x, y});
+    }
+  }
+}
+
+void ThetaStar::init(Coord start, Coord end) {
+  sightChecks = 0;
+  AStar::init(start, end);
+}
+
+// Cells along the segments between the waypoints, for drawing
+std::vector<Coord> ThetaStar::path() {
+  std::vector<Coord> points = waypoints();
+  std::vector<Coord> result;
+  if (points.empty()) return result;
+  result.push_back(points[0]);
+  for (int i=1; i<(int)points.size(); i++) {
+    // Bresenham's line from the previous waypoint
+    Coord a = points[i-1], b = points[i];
+    int dx = std::abs(b.x - a.x), dy = -std::abs(b.y - a.y);
+    int sx = a.x < b.x ? 1 : -1, sy = a.y < b.y ? 1 : -1;
+    int err = dx + dy;
+    while (a.x != b.x || a.y != b.y) {
+      int e2 = 2*err;
+      if (e2 >= dy) {
+        err += dy;
+        a.x += sx;
+      }
+      if (e2 <= dx) {
+        err += dx;
+        a.y += sy;
+      }
+      result.push_back(a);
+    }
+  }
+  return result;
+}
+
+// Corners of the any-angle path from start to end, empty if there is none
+std::vector<Coord> ThetaStar::waypoints() {
+  std::vector<Coord> result;
+  if (state != FOUND) return result;
+  for (Coord cur = end; cur.x != -1; cur = n[board.index(cur)].parent) {
+    result.push_back(cur);
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+// Copy the cell into the wall bits after it was toggled
+void ThetaStar::update(Coord a) {
+  if (!board.inside(a)) return;
+  uint64_t bit = (uint64_t)1 << (a.x % 64);
+  if (board.isFree(a)) walls[(size_t)a.y*words + a.x/64] &= ~bit;
+  else walls[(size_t)a.y*words + a.x/64] |= bit;
+}
+
+// Euclidean distance to the END cell, rounded down to stay a lower bound
+int ThetaStar::estimate(Coord a) {
+  int dx = a.x - end.x, dy = a.y - end.y;
+  return (int)(STRAIGHT_COST*std::sqrt((double)(dx*dx + dy*dy)));
+}
+
+// Reach the 8 neighbors, a diagonal only if both cells beside it are free
+void ThetaStar::expand(Coord cur) {
+  if (lazy) setVertex(cur);
+  for (int k=0; k<8; k++) {
+    Coord b = {cur.x + DX[k], cur.y + DY[k]};
+    if (!board.isFree(b)) continue;
+    if (k >= 4 && (!board.isFree({cur.x + DX[k], cur.y}) || !board.isFree({cur.x, cur.y + DY[k]}))) continue;
+    relax(cur, b);
+  }
+}
+
+// Reach b through the parent of cur if it sees b, else through cur
+void ThetaStar::relax(Coord cur, Coord b) {
+  int id = board.index(b);
+  Node& nb = node(id);
+  if (nb.set & IN_CLOSED) return;
+
+  Node& c = node(board.index(cur));
+  Coord from = cur;
+  if (c.parent.x != -1 && (lazy || lineOfSight(c.parent, b))) from = c.parent;
+  int g = node(board.index(from)).g + distance(from, b);
+  if ((nb.set & IN_OPEN) && g >= nb.g) return;
+
+  nb.g = g;
+  nb.h = estimate(b);
+  nb.f = g + nb.h;
+  nb.parent = from;
+  if (nb.set & IN_OPEN) {
+    openSet.decrease(id, nb.f, nb.h);
+  } else {
+    nb.set = IN_OPEN;
+    openSet.push(id, nb.f, nb.h);
+    generated.push_back(id);
+  }
+}
+
+// Lazy Theta*: if the parent assumed on reaching cur cannot see it, take the
+// expanded neighbor that gives cur the lowest cost instead
+void ThetaStar::setVertex(Coord cur) {
+  Node& s = node(board.index(cur));
+  if (s.parent.x == -1 || lineOfSight(s.parent, cur)) return;
+  s.g = 2147483647;
+  for (int k=0; k<8; k++) {
+    Coord b = {cur.x + DX[k], cur.y + DY[k]};
+    if (!board.isFree(b) || !(node(board.index(b)).set & IN_CLOSED)) continue;
+    if (k >= 4 && (!board.isFree({cur.x + DX[k], cur.y}) || !board.isFree({cur.x, cur.y + DY[k]}))) continue;
+    int g = node(board.index(b)).g + distance(b, cur);
+    if (g < s.g) {
+      s.g = g;
+      s.parent = b;
+    }
+  }
+  s.f = s.g + s.h;
+}
+
+// Whether the segment between the centers of a and b only touches free cells
+// In coordinates doubled so that centers are odd, the segment crosses row y
+// between two heights, and the cells it touches there lie between the two
+// matching abscissas, found exactly as fractions
+bool ThetaStar::lineOfSight(Coord a, Coord b) {
+  sightChecks++;
+  if (a.y > b.y) std::swap(a, b);
+  if (a.y == b.y) return rowClear(a.y, std::min(a.x, b.x), std::max(a.x, b.x));
+
+  long long x0 = 2*a.x + 1, y0 = 2*a.y + 1, y1 = 2*b.y + 1;
+  long long dx = 2*(b.x - a.x), dy = y1 - y0;
+  for (int y=a.y; y<=b.y; y++) {
+    long long bottom = std::max(2LL*y, y0), top = std::min(2LL*y + 2, y1);
+    // Abscissas at both heights, times dy
+    long long p = x0*dy + (bottom - y0)*dx, q = x0*dy + (top - y0)*dx;
+    long long low = std::min(p, q), high = std::max(p, q);
+    int left = (int)std::max(ceilDiv(low - 2*dy, 2*dy), 0LL);
+    int right = (int)std::min(floorDiv(high, 2*dy), (long long)board.width - 1);
+    if (!rowClear(y, left, right)) return false;
+  }
+  return true;
+}
+
+// Whether cells left to right of row y are all free, a word at a time
+bool ThetaStar::rowClear(int y, int left, int right) const {
+  for (int w = left/64; w <= right/64; w++) {
+    int from = std::max(left, w*64) - w*64;
+    int to = std::min(right, w*64 + 63) - w*64;
+    uint64_t mask = (~(uint64_t)0 << from) & (~(uint64_t)0 >> (63 - to));
+    if (walls[(size_t)y*words + w] & mask) return false;
+  }
+  return true;
+}
+
+// Euclidean distance between two cells in STRAIGHT_COST units
+int ThetaStar::distance(Coord a, Coord b) const {
+  int dx = a.x - b.x, dy = a.y - b.y;
+  return (int)std::lround(STRAIGHT_COST*std::sqrt((double)(dx*dx + dy*dy)));
+}
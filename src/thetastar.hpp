@@ -0,0 +1,40 @@
+#ifndef __THETASTAR_HPP__
+#define __THETASTAR_HPP__
+
+#include <cstdint>
+#include <vector>
+#include "astar.hpp"
+
+// Theta*: 8-connected A* whose parents need not be neighbors, so the path is
+// a few straight segments at any angle between cell centers
+// A reached cell takes the parent of the expanded cell if it can see it, and
+// the expanded cell otherwise, with euclidean costs in STRAIGHT_COST units
+// Lazy Theta* assumes it can, and only checks when the cell is expanded,
+// falling back to its best expanded neighbor, for far fewer sight checks
+// Walls are kept as bits, so a line of sight tests the cells it touches in
+// each row with a mask over one or two words, and touching a wall's corner
+// blocks it, as corners are never cut
+// Every cell is taken to cost the same
+class ThetaStar : public AStar {
+public:
+  bool lazy;
+  int words; // 64-bit words per row
+  std::vector<uint64_t> walls;
+  int sightChecks; // Lines of sight tested by the last search
+
+  ThetaStar(const Board& board, bool lazy = false);
+  void init(Coord start, Coord end);
+  std::vector<Coord> path();
+  std::vector<Coord> waypoints();
+  void update(Coord a);
+
+  int estimate(Coord a);
+  void expand(Coord cur);
+  void relax(Coord cur, Coord b);
+  void setVertex(Coord cur);
+  bool lineOfSight(Coord a, Coord b);
+  bool rowClear(int y, int left, int right) const;
+  int distance(Coord a, Coord b) const;
+};
+
+#endif
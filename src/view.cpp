@@ -0,0 +1,197 @@
+#include "view.hpp"
+
+// Constructor, one quad of two triangles per cell
+View::View(const Board& board) : board(board), width(board.width), height(board.height), vertices(36*board.width*board.height) {
+  // Initialize vertices and colors of the board, cells too small for a margin have none
+  margin = (SCREEN_WIDTH/width >= 8 && SCREEN_HEIGHT/height >= 8) ? 2 : 0;
+  clean();
+  for (int i=0; i<width; i++) {
+    for (int j=0; j<height; j++) {
+      vertices[36*index({i, j})+ 0] = screenToOpenGL(SCREEN_WIDTH*i/width+margin, SCREEN_WIDTH); // Bottom-left
+      vertices[36*index({i, j})+ 1] = screenToOpenGL(SCREEN_HEIGHT*j/height+margin, SCREEN_HEIGHT); // TODO - Check if this is correct
+      vertices[36*index({i, j})+ 2] = 0.0f;
+      vertices[36*index({i, j})+ 3] = 1.0f;
+      vertices[36*index({i, j})+ 4] = 1.0f;
+      vertices[36*index({i, j})+ 5] = 1.0f;
+      vertices[36*index({i, j})+ 6] = screenToOpenGL(SCREEN_WIDTH*(i+1)/width-margin, SCREEN_WIDTH); // Bottom-right
+      vertices[36*index({i, j})+ 7] = screenToOpenGL(SCREEN_HEIGHT*j/height+margin, SCREEN_HEIGHT);
+      vertices[36*index({i, j})+ 8] = 0.0f;
+      vertices[36*index({i, j})+ 9] = 1.0f;
+      vertices[36*index({i, j})+10] = 1.0f;
+      vertices[36*index({i, j})+11] = 1.0f;
+      vertices[36*index({i, j})+12] = screenToOpenGL(SCREEN_WIDTH*(i+1)/width-margin, SCREEN_WIDTH); // Top-right
+      vertices[36*index({i, j})+13] = screenToOpenGL(SCREEN_HEIGHT*(j+1)/height-margin, SCREEN_HEIGHT);
+      vertices[36*index({i, j})+14] = 0.0f;
+      vertices[36*index({i, j})+15] = 1.0f;
+      vertices[36*index({i, j})+16] = 1.0f;
+      vertices[36*index({i, j})+17] = 1.0f;
+      vertices[36*index({i, j})+18] = screenToOpenGL(SCREEN_WIDTH*i/width+margin, SCREEN_WIDTH); // Bottom-left
+      vertices[36*index({i, j})+19] = screenToOpenGL(SCREEN_HEIGHT*j/height+margin, SCREEN_HEIGHT);
+      vertices[36*index({i, j})+20] = 0.0f;
+      vertices[36*index({i, j})+21] = 1.0f;
+      vertices[36*index({i, j})+22] = 1.0f;
+      vertices[36*index({i, j})+23] = 1.0f;
+      vertices[36*index({i, j})+24] = screenToOpenGL(SCREEN_WIDTH*i/width+margin, SCREEN_WIDTH); // Top-left
+      vertices[36*index({i, j})+25] = screenToOpenGL(SCREEN_HEIGHT*(j+1)/height-margin, SCREEN_HEIGHT);
+      vertices[36*index({i, j})+26] = 0.0f;
+      vertices[36*index({i, j})+27] = 1.0f;
+      vertices[36*index({i, j})+28] = 1.0f;
+      vertices[36*index({i, j})+29] = 1.0f;
+      vertices[36*index({i, j})+30] = screenToOpenGL(SCREEN_WIDTH*(i+1)/width-margin, SCREEN_WIDTH); // Top-right
+      vertices[36*index({i, j})+31] = screenToOpenGL(SCREEN_HEIGHT*(j+1)/height-margin, SCREEN_HEIGHT);
+      vertices[36*index({i, j})+32] = 0.0f;
+      vertices[36*index({i, j})+33] = 1.0f;
+      vertices[36*index({i, j})+34] = 1.0f;
+      vertices[36*index({i, j})+35] = 1.0f;
+    }
+  }
+}
+
+// This function converts the screen coordinates to OpenGL coordinates
+float View::screenToOpenGL(int screenCoord, int screenSize) {
+  return (float)screenCoord / (float)screenSize * 2.0f - 1.0f;
+}
+
+// Index of the quad of a cell, in the same row-major order as the board
+int View::index(Coord a) {
+  return a.y*width + a.x;
+}
+
+// Change color of cell a
+void View::changeColor(Coord a, Board::Status s) {
+  touch(a);
+  switch(s) {
+    case Board::EMPTY: { // White, shaded darker with the terrain cost
+      float t = 1.0f - 1.0f / board.cell(a).cost;
+      setColor(a, 1.0f - 0.5f*t, 1.0f - 0.6f*t, 1.0f - 0.8f*t);
+      break;
+    }
+    
+    case Board::WALL: // Black
+      vertices[36*index(a)+ 3] = 0.0f;
+      vertices[36*index(a)+ 4] = 0.0f;
+      vertices[36*index(a)+ 5] = 0.0f;
+      vertices[36*index(a)+ 9] = 0.0f;
+      vertices[36*index(a)+10] = 0.0f;
+      vertices[36*index(a)+11] = 0.0f;
+      vertices[36*index(a)+15] = 0.0f;
+      vertices[36*index(a)+16] = 0.0f;
+      vertices[36*index(a)+17] = 0.0f;
+      vertices[36*index(a)+21] = 0.0f;
+      vertices[36*index(a)+22] = 0.0f;
+      vertices[36*index(a)+23] = 0.0f;
+      vertices[36*index(a)+27] = 0.0f;
+      vertices[36*index(a)+28] = 0.0f;
+      vertices[36*index(a)+29] = 0.0f;
+      vertices[36*index(a)+33] = 0.0f;
+      vertices[36*index(a)+34] = 0.0f;
+      vertices[36*index(a)+35] = 0.0f;
+      break;
+    
+    case Board::CHECKED: // Green
+      vertices[36*index(a)+ 3] = 0.0f;
+      vertices[36*index(a)+ 4] = 1.0f;
+      vertices[36*index(a)+ 5] = 0.0f;
+      vertices[36*index(a)+ 9] = 0.0f;
+      vertices[36*index(a)+10] = 1.0f;
+      vertices[36*index(a)+11] = 0.0f;
+      vertices[36*index(a)+15] = 0.0f;
+      vertices[36*index(a)+16] = 1.0f;
+      vertices[36*index(a)+17] = 0.0f;
+      vertices[36*index(a)+21] = 0.0f;
+      vertices[36*index(a)+22] = 1.0f;
+      vertices[36*index(a)+23] = 0.0f;
+      vertices[36*index(a)+27] = 0.0f;
+      vertices[36*index(a)+28] = 1.0f;
+      vertices[36*index(a)+29] = 0.0f;
+      vertices[36*index(a)+33] = 0.0f;
+      vertices[36*index(a)+34] = 1.0f;
+      vertices[36*index(a)+35] = 0.0f;
+      break;
+    
+    case Board::START: // Red
+      vertices[36*index(a)+ 3] = 1.0f;
+      vertices[36*index(a)+ 4] = 0.0f;
+      vertices[36*index(a)+ 5] = 0.0f;
+      vertices[36*index(a)+ 9] = 1.0f;
+      vertices[36*index(a)+10] = 0.0f;
+      vertices[36*index(a)+11] = 0.0f;
+      vertices[36*index(a)+15] = 1.0f;
+      vertices[36*index(a)+16] = 0.0f;
+      vertices[36*index(a)+17] = 0.0f;
+      vertices[36*index(a)+21] = 1.0f;
+      vertices[36*index(a)+22] = 0.0f;
+      vertices[36*index(a)+23] = 0.0f;
+      vertices[36*index(a)+27] = 1.0f;
+      vertices[36*index(a)+28] = 0.0f;
+      vertices[36*index(a)+29] = 0.0f;
+      vertices[36*index(a)+33] = 1.0f;
+      vertices[36*index(a)+34] = 0.0f;
+      vertices[36*index(a)+35] = 0.0f;
+      break;
+
+    case Board::END: // Blue
+      vertices[36*index(a)+ 3] = 0.0f;
+      vertices[36*index(a)+ 4] = 0.0f;
+      vertices[36*index(a)+ 5] = 1.0f;
+      vertices[36*index(a)+ 9] = 0.0f;
+      vertices[36*index(a)+10] = 0.0f;
+      vertices[36*index(a)+11] = 1.0f;
+      vertices[36*index(a)+15] = 0.0f;
+      vertices[36*index(a)+16] = 0.0f;
+      vertices[36*index(a)+17] = 1.0f;
+      vertices[36*index(a)+21] = 0.0f;
+      vertices[36*index(a)+22] = 0.0f;
+      vertices[36*index(a)+23] = 1.0f;
+      vertices[36*index(a)+27] = 0.0f;
+      vertices[36*index(a)+28] = 0.0f;
+      vertices[36*index(a)+29] = 1.0f;
+      vertices[36*index(a)+33] = 0.0f;
+      vertices[36*index(a)+34] = 0.0f;
+      vertices[36*index(a)+35] = 1.0f;
+      break;
+
+    case Board::PATH: // Rainbow
+      vertices[36*index(a)+ 3] = 1.0f;
+      vertices[36*index(a)+ 4] = 1.0f;
+      vertices[36*index(a)+ 5] = 0.0f;
+      vertices[36*index(a)+ 9] = 0.0f;
+      vertices[36*index(a)+10] = 1.0f;
+      vertices[36*index(a)+11] = 1.0f;
+      vertices[36*index(a)+15] = 1.0f;
+      vertices[36*index(a)+16] = 0.0f;
+      vertices[36*index(a)+17] = 1.0f;
+      vertices[36*index(a)+21] = 1.0f;
+      vertices[36*index(a)+22] = 1.0f;
+      vertices[36*index(a)+23] = 0.0f;
+      vertices[36*index(a)+27] = 1.0f;
+      vertices[36*index(a)+28] = 1.0f;
+      vertices[36*index(a)+29] = 1.0f;
+      vertices[36*index(a)+33] = 1.0f;
+      vertices[36*index(a)+34] = 0.0f;
+      vertices[36*index(a)+35] = 1.0f;
+      break;
+  }
+}
+
+// Set the color of the 6 vertices of cell a
+void View::setColor(Coord a, float r, float g, float b) {
+  touch(a);
+  for (int k=0; k<6; k++) {
+    vertices[36*index(a) + 6*k + 3] = r;
+    vertices[36*index(a) + 6*k + 4] = g;
+    vertices[36*index(a) + 6*k + 5] = b;
+  }
+}
+
+// Widen the range of quads to upload to cover cell a
+void View::touch(Coord a) {
+  if (index(a) < low) low = index(a);
+  if (index(a) > high) high = index(a);
+}
+
+// Forget the changed quads, once they are uploaded
+void View::clean() {
+  low = width*height;
+  high = -1;
+}
@@ -0,0 +1,28 @@
+#ifndef __VIEW_HPP__
+#define __VIEW_HPP__
+
+#include <vector>
+#include "board.hpp"
+
+#define SCREEN_WIDTH 800
+#define SCREEN_HEIGHT 800
+
+// Vertices and colors of the board as drawn by the front end
+class View {
+public:
+  const Board& board;
+  int width, height;
+  int margin;
+  std::vector<float> vertices;
+  int low, high; // Quads changed since the last upload, none if low > high
+
+  View(const Board& board);
+  float screenToOpenGL(int screenCoord, int screenSize);
+  int index(Coord a);
+  void changeColor(Coord a, Board::Status s);
+  void setColor(Coord a, float r, float g, float b);
+  void touch(Coord a);
+  void clean();
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include "whca.hpp"
+
+// Directions to the 4 neighbors, as in SpaceTimeAStar
+static const int DX[4] = {-1, 1, 0, 0};
+static const int DY[4] = {0, 0, -1, 1};
+
+// Constructor, every slot starts empty
+ReservationTable::ReservationTable(const Board& board, int span) : ConstraintTable(board), span(span) {
+  ring.assign((size_t)span*board.width*board.height, {-1, -1});
+  agent = -1;
+}
+
+void ReservationTable::reserve(Coord a, int t, int agent) {
+  ring[(size_t)(t % span)*board.width*board.height + board.index(a)] = {t, agent};
+}
+
+// Give back a cell reserved by the agent, if it still holds it
+void ReservationTable::release(Coord a, int t, int agent) {
+  Slot& slot = ring[(size_t)(t % span)*board.width*board.height + board.index(a)];
+  if (slot.t == t && slot.agent == agent) slot.t = -1;
+}
+
+// Agent holding a at time t, -1 if none
+int ReservationTable::owner(Coord a, int t) const {
+  const Slot& slot = ring[(size_t)(t % span)*board.width*board.height + board.index(a)];
+  return slot.t == t ? slot.agent : -1;
+}
+
+bool ReservationTable::blocked(Coord a, int t) const {
+  int o = owner(a, t);
+  return o != -1 && o != agent;
+}
+
+// A move is blocked if another agent comes the other way at the same time
+bool ReservationTable::blockedEdge(Coord a, int k, int t) const {
+  int o = owner({a.x + DX[k], a.y + DY[k]}, t - 1);
+  return o != -1 && o != agent && owner(a, t) == o;
+}
+
+// Reservations end with the window, so END is never held forever
+int ReservationTable::last(Coord) const {
+  return -1;
+}
+
+// Constructor, the ring covers the window and the current step
+WHCAStar::WHCAStar(const Board& board, int window) : board(board), window(window), reservations(board, window + 1), low(board) {
+  interval = std::max(window / 2, 1);
+  time = 0;
+  replans = 0;
+  expanded = 0;
+  collisions = 0;
+  seen.assign(board.width*board.height, 0);
+}
+
+// Add an agent on start, it plans on the next tick
+int WHCAStar::add(Coord start, Coord end) {
+  int goal = 0;
+  while (goal < (int)goals.size() && (goals[goal].x != end.x || goals[goal].y != end.y)) goal++;
+  if (goal == (int)goals.size()) {
+    goals.push_back(end);
+    toGoal.push_back(std::vector<int>());
+    low.distances(end, toGoal.back());
+  }
+  Agent agent;
+  agent.position = start;
+  agent.end = end;
+  agent.plan.assign(1, start);
+  agent.planned = time;
+  agent.goal = goal;
+  agents.push_back(agent);
+  reservations.reserve(start, time, (int)agents.size() - 1);
+  return (int)agents.size() - 1;
+}
+
+// Replan the agents whose turn it is, then move every agent one step
+void WHCAStar::tick() {
+  replans = 0;
+  expanded = 0;
+  for (int i=0; i<(int)agents.size(); i++) {
+    const Agent& a = agents[i];
+    if ((time + i) % interval == 0 || a.planned + (int)a.plan.size() - 1 <= time) replan(i);
+  }
+
+  time++;
+  for (int i=0; i<(int)agents.size(); i++) {
+    agents[i].position = at(i, time);
+    int id = board.index(agents[i].position);
+    if (seen[id] == (unsigned int)time) collisions++;
+    seen[id] = (unsigned int)time;
+  }
+}
+
+// Plan an agent for the next window steps around the others' reservations
+// If none is found, it keeps what is left of its plan, or waits
+void WHCAStar::replan(int i) {
+  Agent& a = agents[i];
+  for (int k=0; k<(int)a.plan.size(); k++) {
+    if (a.planned + k >= time) reservations.release(a.plan[k], a.planned + k, i);
+  }
+
+  reservations.agent = i;
+  std::vector<Coord> path = low.findPath(a.position, a.end, toGoal[a.goal], reservations, time, window);
+  expanded += low.expanded;
+  replans++;
+  if (path.empty()) {
+    int k = time - a.planned;
+    if (k < (int)a.plan.size()) path.assign(a.plan.begin() + k, a.plan.end());
+    else path.assign(1, a.position);
+  }
+
+  a.plan = path;
+  a.planned = time;
+  for (int k=0; k<(int)a.plan.size(); k++) {
+    reservations.reserve(a.plan[k], time + k, i);
+  }
+}
+
+// Cell of an agent at time t, staying on the last cell of its plan
+Coord WHCAStar::at(int i, int t) const {
+  const Agent& a = agents[i];
+  int k = t - a.planned;
+  return k < (int)a.plan.size() ? a.plan[k] : a.plan.back();
+}
+
+// Whether every agent is on its END
+bool WHCAStar::arrived() const {
+  for (int i=0; i<(int)agents.size(); i++) {
+    if (agents[i].position.x != agents[i].end.x || agents[i].position.y != agents[i].end.y) return false;
+  }
+  return true;
+}
@@ -0,0 +1,65 @@
+#ifndef __WHCA_HPP__
+#define __WHCA_HPP__
+
+#include <vector>
+#include "spacetime.hpp"
+
+// Cells reserved by the agents for the next time steps, in a ring buffer of
+// span steps per cell: a slot only holds time t while t is not span steps old,
+// so reservations expire as time passes without ever being cleared
+// Cells reserved by the agent being planned are free to it
+class ReservationTable : public ConstraintTable {
+public:
+  typedef struct Slot {
+    int t, agent;
+  } Slot;
+
+  int span;
+  std::vector<Slot> ring; // span slots per cell, indexed by t % span
+  int agent; // Agent being planned
+
+  ReservationTable(const Board& board, int span);
+  void reserve(Coord a, int t, int agent);
+  void release(Coord a, int t, int agent);
+  int owner(Coord a, int t) const;
+  bool blocked(Coord a, int t) const;
+  bool blockedEdge(Coord a, int k, int t) const;
+  int last(Coord a) const;
+};
+
+// Windowed Hierarchical Cooperative A*: agents move one cell per tick, each
+// following a plan of window steps made by the space-time A* around the cells
+// the others reserved, with the exact cost to its END as the heuristic
+// An agent plans again every interval ticks, half the window, and the agents
+// take turns in that cycle, so every tick only replans a fixed share of them
+class WHCAStar {
+public:
+  typedef struct Agent {
+    Coord position, end;
+    std::vector<Coord> plan; // Cells from time planned on, reserved
+    int planned;
+    int goal; // Heuristic table of END in toGoal
+  } Agent;
+
+  const Board& board;
+  int window, interval;
+  int time;
+  ReservationTable reservations;
+  SpaceTimeAStar low;
+  std::vector<Agent> agents;
+  std::vector<Coord> goals; // ENDs with a heuristic table
+  std::vector<std::vector<int> > toGoal;
+  int replans;     // Plans made by the last tick
+  long expanded;   // States expanded by the last tick
+  int collisions;  // Agents that ended a tick on the same cell, when a plan could not be found
+  std::vector<unsigned int> seen;
+
+  WHCAStar(const Board& board, int window = 16);
+  int add(Coord start, Coord end);
+  void tick();
+  void replan(int i);
+  Coord at(int i, int t) const;
+  bool arrived() const;
+};
+
+#endif
@@ -0,0 +1,605 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <vector>
+#include "astar.hpp"
+#include "gridastar.hpp"
+#include "jps.hpp"
+#include "jpsplus.hpp"
+#include "bidirectional.hpp"
+#include "landmarks.hpp"
+#include "pathcache.hpp"
+#include "dstarlite.hpp"
+#include "hpa.hpp"
+#include "components.hpp"
+#include "flowfield.hpp"
+#include "arastar.hpp"
+#include "thetastar.hpp"
+#include "bitbfs.hpp"
+#include "hda.hpp"
+#include "batch.hpp"
+#include "cbs.hpp"
+#include "whca.hpp"
+
+// Paths of the solvers checked against a Dijkstra search on random boards:
+// every path must be valid and cost exactly as much as the shortest one
+// Returns non-zero on the first failure, for ctest
+
+// Random board with the given percentage of walls, and terrain costs up to maxCost
+Board makeBoard(int width, int height, unsigned int seed, int walls, int maxCost) {
+  std::mt19937 rng(seed);
+  Board board(width, height);
+  for (int i=0; i<width*height; i++) {
+    if ((int)(rng() % 100) < walls) board.c[i].status = Board::WALL;
+    board.setCost(board.coord(i), 1 + (int)(rng() % maxCost));
+  }
+  return board;
+}
+
+// Whether a move from a to b by (dx, dy) is allowed, 4-connected if eight is false
+bool canMove(const Board& board, Coord a, int dx, int dy, bool eight, CornerRule corners) {
+  if (!board.isFree({a.x + dx, a.y + dy})) return false;
+  if (dx == 0 || dy == 0) return true;
+  if (!eight) return false;
+  bool horizontal = board.isFree({a.x + dx, a.y});
+  bool vertical = board.isFree({a.x, a.y + dy});
+  if (corners == CUT_NEVER) return horizontal && vertical;
+  if (corners == CUT_ONE_FREE) return horizontal || vertical;
+  return true;
+}
+
+// Cost of a move into b, with the same units as the solvers
+int moveCost(const Board& board, Coord b, int dx, int dy, bool eight) {
+  if (!eight) return board.cell(b).cost;
+  return (dx != 0 && dy != 0 ? DIAGONAL_COST : STRAIGHT_COST)*board.cell(b).cost;
+}
+
+// Cost of the shortest path from start to end, -1 if there is none
+int dijkstra(const Board& board, Coord start, Coord end, bool eight, CornerRule corners) {
+  typedef std::pair<int, int> Item;
+  std::vector<int> dist(board.width*board.height, 2147483647);
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item> > queue;
+  dist[board.index(start)] = 0;
+  queue.push({0, board.index(start)});
+  while (!queue.empty()) {
+    Item top = queue.top();
+    queue.pop();
+    if (top.first > dist[top.second]) continue;
+    Coord a = board.coord(top.second);
+    if (a.x == end.x && a.y == end.y) return top.first;
+    for (int dx=-1; dx<=1; dx++) {
+      for (int dy=-1; dy<=1; dy++) {
+        if ((dx == 0 && dy == 0) || !canMove(board, a, dx, dy, eight, corners)) continue;
+        Coord b = {a.x + dx, a.y + dy};
+        int d = top.first + moveCost(board, b, dx, dy, eight);
+        if (d < dist[board.index(b)]) {
+          dist[board.index(b)] = d;
+          queue.push({d, board.index(b)});
+        }
+      }
+    }
+  }
+  return -1;
+}
+
+// Cost of a path from start to end, -1 if it is not a valid one
+int pathCost(const Board& board, const std::vector<Coord>& path, Coord start, Coord end, bool eight, CornerRule corners) {
+  if (path.empty()) return -1;
+  if (path.front().x != start.x || path.front().y != start.y) return -1;
+  if (path.back().x != end.x || path.back().y != end.y) return -1;
+  int cost = 0;
+  for (int i=1; i<(int)path.size(); i++) {
+    int dx = path[i].x - path[i-1].x, dy = path[i].y - path[i-1].y;
+    if (std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0)) return -1;
+    if (!canMove(board, path[i-1], dx, dy, eight, corners)) return -1;
+    cost += moveCost(board, path[i], dx, dy, eight);
+  }
+  return cost;
+}
+
+// Compare the path found for a query with the reference, printing any mismatch
+bool compare(const char* name, const std::vector<Coord>& path, const Board& board, Coord start, Coord end, bool eight = false, CornerRule corners = CUT_NEVER) {
+  int expected = dijkstra(board, start, end, eight, corners);
+  int cost = path.empty() ? -1 : pathCost(board, path, start, end, eight, corners);
+  if (expected == -1 && path.empty()) return true;
+  if (cost != -1 && cost == expected) return true;
+  std::cout << "[FAIL] " << name << " (" << start.x << ", " << start.y << ") to (" << end.x << ", " << end.y
+            << "): cost " << cost << ", expected " << expected << (cost == -1 && !path.empty() ? ", invalid path" : "") << std::endl;
+  return false;
+}
+
+// Solve one query and compare with the reference
+bool check(const char* name, AStar& solver, const Board& board, Coord start, Coord end, bool eight = false, CornerRule corners = CUT_NEVER) {
+  return compare(name, solver.findPath(start, end), board, start, end, eight, corners);
+}
+
+// Free start and end cells picked at random
+bool randomQuery(const Board& board, std::mt19937& rng, Coord& start, Coord& end) {
+  start = {(int)(rng() % board.width), (int)(rng() % board.height)};
+  end = {(int)(rng() % board.width), (int)(rng() % board.height)};
+  return board.isFree(start) && board.isFree(end);
+}
+
+// Toggle a random cell other than the given ones, true if one was toggled
+bool toggle(Board& board, std::mt19937& rng, Coord& a, Coord keep1, Coord keep2) {
+  a = {(int)(rng() % board.width), (int)(rng() % board.height)};
+  if ((a.x == keep1.x && a.y == keep1.y) || (a.x == keep2.x && a.y == keep2.y)) return false;
+  board.cell(a).status = board.isWall(a) ? Board::EMPTY : Board::WALL;
+  return true;
+}
+
+// D* Lite keeps its plan for one END while walls are toggled and the start moves
+bool testDStarLite() {
+  for (unsigned int seed=1; seed<=30; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(8 + rng() % 40, 8 + rng() % 40, seed, rng() % 30, 1);
+    DStarLite dstar(board);
+    Coord start, end;
+    while (!randomQuery(board, rng, start, end)) {}
+    if (!check("D* Lite", dstar, board, start, end)) return false;
+    for (int round=0; round<40; round++) {
+      Coord a;
+      if (toggle(board, rng, a, start, end)) dstar.update(a);
+      // Now and then the start moves, which shifts the keys by km
+      if (round % 5 == 4) {
+        Coord moved = {(int)(rng() % board.width), (int)(rng() % board.height)};
+        if (board.isFree(moved) && (moved.x != end.x || moved.y != end.y)) start = moved;
+      }
+      if (!check("D* Lite", dstar, board, start, end)) return false;
+    }
+  }
+  return true;
+}
+
+// JPS+ rebuilds its jump table after the walls toggled through JumpTable::update
+bool testJPSPlus() {
+  for (unsigned int seed=1; seed<=30; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(8 + rng() % 40, 8 + rng() % 40, seed, rng() % 30, 1);
+    JumpTable table(board);
+    JPSPlus jps(board, table);
+    for (int round=0; round<20; round++) {
+      Coord start, end, a;
+      for (int q=0; q<5; q++) {
+        if (!randomQuery(board, rng, start, end)) continue;
+        if (!check("JPS+", jps, board, start, end, true, CUT_NEVER)) return false;
+      }
+      for (int t=0; t<3; t++) {
+        if (toggle(board, rng, a, {-1, -1}, {-1, -1})) table.update(a);
+      }
+    }
+  }
+  return true;
+}
+
+// HDA* splits the search between its threads, unreachable ENDs included
+bool testHDAStar() {
+  int unreachable = 0;
+  for (unsigned int seed=1; seed<=20; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(8 + rng() % 40, 8 + rng() % 40, seed, 20 + rng() % 25, 1);
+    HDAStar hda(board, 4);
+    for (int q=0; q<10; q++) {
+      Coord start, end;
+      if (!randomQuery(board, rng, start, end)) continue;
+      if (dijkstra(board, start, end, false, CUT_NEVER) == -1) unreachable++;
+      if (!compare("HDA*", hda.findPath(start, end), board, start, end)) return false;
+    }
+  }
+  if (unreachable == 0) std::cout << "[FAIL] HDA*: no unreachable query was checked" << std::endl;
+  return unreachable > 0;
+}
+
+// A batch of queries shared by the worker threads, each answered like alone
+bool testBatch() {
+  for (unsigned int seed=1; seed<=10; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(8 + rng() % 40, 8 + rng() % 40, seed, rng() % 35, seed % 2 ? 1 : 8);
+    BatchSolver batch(board, 4);
+    std::vector<BatchSolver::Query> queries;
+    while (queries.size() < 64) {
+      Coord start, end;
+      if (randomQuery(board, rng, start, end)) queries.push_back({start, end});
+    }
+    std::vector<std::vector<Coord> > paths = batch.solve(queries);
+    for (int q=0; q<(int)queries.size(); q++) {
+      if (!compare("A* (batch)", paths[q], board, queries[q].start, queries[q].end)) return false;
+    }
+  }
+  return true;
+}
+
+// The bitboard BFS on rows that end inside a word, or span more than one,
+// kept in step with the walls through update()
+bool testBitBFS() {
+  int widths[] = {37, 64, 70, 130};
+  for (unsigned int seed=1; seed<=20; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(widths[seed % 4], 8 + rng() % 40, seed, rng() % 35, 1);
+    BitBFS bfs(board);
+    for (int round=0; round<20; round++) {
+      Coord start, end, a;
+      for (int q=0; q<5; q++) {
+        if (!randomQuery(board, rng, start, end)) continue;
+        if (!check("BFS (bitboards)", bfs, board, start, end)) return false;
+      }
+      if (toggle(board, rng, a, {-1, -1}, {-1, -1})) bfs.update(a);
+    }
+  }
+  return true;
+}
+
+// Distinct free starts and ENDs, each END reachable from its start
+std::vector<CBS::Agent> randomAgents(const Board& board, std::mt19937& rng, int count) {
+  std::vector<CBS::Agent> agents;
+  std::vector<bool> used(board.width*board.height, false);
+  while ((int)agents.size() < count) {
+    Coord start, end;
+    if (!randomQuery(board, rng, start, end) || used[board.index(start)] || used[board.index(end)]) continue;
+    if (board.index(start) == board.index(end) || dijkstra(board, start, end, false, CUT_NEVER) == -1) continue;
+    used[board.index(start)] = used[board.index(end)] = true;
+    agents.push_back({start, end});
+  }
+  return agents;
+}
+
+// Whether the agents, waiting at their END once there, never share a cell
+// at the same time nor swap places
+bool collisionFree(const std::vector<std::vector<Coord> >& paths) {
+  int length = 0;
+  for (int i=0; i<(int)paths.size(); i++) {
+    length = std::max(length, (int)paths[i].size());
+  }
+  for (int t=0; t<length; t++) {
+    for (int i=0; i<(int)paths.size(); i++) {
+      for (int j=i+1; j<(int)paths.size(); j++) {
+        Coord a = CBS::at(paths[i], t), b = CBS::at(paths[j], t);
+        if (a.x == b.x && a.y == b.y) return false;
+        Coord na = CBS::at(paths[i], t + 1), nb = CBS::at(paths[j], t + 1);
+        if (a.x == nb.x && a.y == nb.y && b.x == na.x && b.y == na.y) return false;
+      }
+    }
+  }
+  return true;
+}
+
+// CBS paths go from each start to its END one cell or one wait at a time,
+// without conflicts, and cost no less than the agents planned alone
+bool testCBS() {
+  int solved = 0;
+  for (unsigned int seed=1; seed<=10; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(20, 20, seed, 15, seed % 2 ? 1 : 4);
+    std::vector<CBS::Agent> agents = randomAgents(board, rng, 6 + seed % 3);
+    CBS cbs(board);
+    if (!cbs.solve(agents, 5.0)) {
+      if (cbs.timedOut) continue;
+      std::cout << "[FAIL] CBS " << agents.size() << " agents: no solution" << std::endl;
+      return false;
+    }
+    solved++;
+    int total = 0, alone = 0;
+    for (int i=0; i<(int)agents.size(); i++) {
+      const std::vector<Coord>& path = cbs.paths[i];
+      bool valid = !path.empty() && path.front().x == agents[i].start.x && path.front().y == agents[i].start.y &&
+                   path.back().x == agents[i].end.x && path.back().y == agents[i].end.y;
+      for (int t=1; valid && t<(int)path.size(); t++) {
+        int dx = std::abs(path[t].x - path[t-1].x), dy = std::abs(path[t].y - path[t-1].y);
+        valid = dx + dy <= 1 && board.isFree(path[t]);
+      }
+      if (!valid) {
+        std::cout << "[FAIL] CBS agent " << i << ": invalid path" << std::endl;
+        return false;
+      }
+      total += cbs.low.cost(path);
+      alone += dijkstra(board, agents[i].start, agents[i].end, false, CUT_NEVER);
+    }
+    if (!collisionFree(cbs.paths)) {
+      std::cout << "[FAIL] CBS " << agents.size() << " agents: two of them collide" << std::endl;
+      return false;
+    }
+    if (total < alone) {
+      std::cout << "[FAIL] CBS " << agents.size() << " agents: cost " << total << ", below " << alone << std::endl;
+      return false;
+    }
+  }
+  if (solved == 0) std::cout << "[FAIL] CBS: every instance timed out" << std::endl;
+  return solved > 0;
+}
+
+// WHCA* agents step one cell at a time around each other's reservations
+// until every one of them stands on its END
+bool testWHCAStar() {
+  for (unsigned int seed=1; seed<=10; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(20, 20, seed, 10, seed % 2 ? 1 : 4);
+    std::vector<CBS::Agent> agents = randomAgents(board, rng, 6 + seed % 3);
+    WHCAStar whca(board, 16);
+    std::vector<std::vector<Coord> > walks(agents.size());
+    for (int i=0; i<(int)agents.size(); i++) {
+      whca.add(agents[i].start, agents[i].end);
+      walks[i].push_back(agents[i].start);
+    }
+    for (int t=0; t<1000 && !whca.arrived(); t++) {
+      whca.tick();
+      for (int i=0; i<(int)agents.size(); i++) {
+        Coord a = whca.agents[i].position, b = walks[i].back();
+        if (std::abs(a.x - b.x) + std::abs(a.y - b.y) > 1 || !board.isFree(a)) {
+          std::cout << "[FAIL] WHCA* agent " << i << ": invalid move" << std::endl;
+          return false;
+        }
+        walks[i].push_back(a);
+      }
+    }
+    for (int i=0; i<(int)agents.size(); i++) {
+      Coord a = whca.agents[i].position;
+      if (a.x != agents[i].end.x || a.y != agents[i].end.y) {
+        std::cout << "[FAIL] WHCA* agent " << i << ": stopped at (" << a.x << ", " << a.y << ")" << std::endl;
+        return false;
+      }
+    }
+    if (whca.collisions != 0 || !collisionFree(walks)) {
+      std::cout << "[FAIL] WHCA* " << agents.size() << " agents: two of them collide" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// ARA* ends on the shortest path given the time, and every path it reports
+// on the way costs no more than its bound times the optimum
+bool testARAStar() {
+  for (unsigned int seed=1; seed<=30; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(8 + rng() % 40, 8 + rng() % 40, seed, rng() % 30, 8);
+    ARAStar ara(board);
+    Coord start, end;
+    while (!randomQuery(board, rng, start, end)) {}
+    int optimum = dijkstra(board, start, end, false, CUT_NEVER);
+    bool valid = true;
+    double last = 0;
+    ara.improved = [&](const std::vector<Coord>& path, double bound) {
+      int cost = pathCost(board, path, start, end, false, CUT_NEVER);
+      if (bound < 1 || (last > 0 && bound > last) || cost == -1 || cost > bound*optimum) valid = false;
+      last = bound;
+    };
+    std::vector<Coord> path = ara.solve(start, end, 10.0);
+    if (!valid) {
+      std::cout << "[FAIL] ARA* (" << start.x << ", " << start.y << ") to (" << end.x << ", " << end.y << "): a path broke its bound" << std::endl;
+      return false;
+    }
+    if (ara.timedOut || !compare("ARA*", path, board, start, end)) return false;
+  }
+
+  // Out of time, the path found so far is still a path
+  Board board = makeBoard(300, 300, 1, 20, 8);
+  board.cell({0, 0}).status = board.cell({299, 299}).status = Board::EMPTY;
+  ARAStar ara(board);
+  std::vector<Coord> path = ara.solve({0, 0}, {299, 299}, 1e-9);
+  if (!ara.timedOut || (!path.empty() && pathCost(board, path, {0, 0}, {299, 299}, false, CUT_NEVER) == -1)) {
+    std::cout << "[FAIL] ARA* out of time: " << (ara.timedOut ? "invalid path" : "not timed out") << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Theta* and its lazy variant: waypoints see each other, the cells drawn
+// between them are free, and there is a path exactly when Dijkstra finds one
+bool checkTheta(const char* name, ThetaStar& theta, const Board& board, Coord start, Coord end) {
+  bool reachable = dijkstra(board, start, end, false, CUT_NEVER) != -1;
+  std::vector<Coord> path = theta.findPath(start, end);
+  std::vector<Coord> points = theta.waypoints();
+  bool valid = path.empty() != reachable;
+  for (int i=1; valid && i<(int)points.size(); i++) {
+    valid = theta.lineOfSight(points[i-1], points[i]);
+  }
+  if (valid && !path.empty()) {
+    valid = path.front().x == start.x && path.front().y == start.y && path.back().x == end.x && path.back().y == end.y;
+  }
+  for (int i=0; valid && i<(int)path.size(); i++) {
+    valid = board.isFree(path[i]) && (i == 0 || (std::abs(path[i].x - path[i-1].x) <= 1 && std::abs(path[i].y - path[i-1].y) <= 1));
+  }
+  if (!valid) {
+    std::cout << "[FAIL] " << name << " (" << start.x << ", " << start.y << ") to (" << end.x << ", " << end.y << "): "
+              << (reachable ? "reachable" : "unreachable") << ", " << path.size() << " cells" << std::endl;
+  }
+  return valid;
+}
+
+bool testThetaStar() {
+  for (unsigned int seed=1; seed<=30; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(8 + rng() % 40, 8 + rng() % 40, seed, rng() % 35, 1);
+    ThetaStar theta(board), lazy(board, true);
+    for (int round=0; round<20; round++) {
+      Coord start, end, a;
+      for (int q=0; q<5; q++) {
+        if (!randomQuery(board, rng, start, end)) continue;
+        if (!checkTheta("Theta*", theta, board, start, end)) return false;
+        if (!checkTheta("Lazy Theta*", lazy, board, start, end)) return false;
+      }
+      if (toggle(board, rng, a, {-1, -1}, {-1, -1})) {
+        theta.update(a);
+        lazy.update(a);
+      }
+    }
+  }
+  return true;
+}
+
+// HPA* paths are not the shortest, but valid whenever there is one, also
+// after walls toggled inside clusters and on their borders
+bool testHPA() {
+  for (unsigned int seed=1; seed<=30; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(8 + rng() % 40, 8 + rng() % 40, seed, rng() % 35, 1);
+    HPA hpa(board, 8);
+    HPAStar solver(board, hpa);
+    for (int round=0; round<20; round++) {
+      Coord start, end, a;
+      for (int q=0; q<5; q++) {
+        if (!randomQuery(board, rng, start, end)) continue;
+        bool reachable = dijkstra(board, start, end, false, CUT_NEVER) != -1;
+        std::vector<Coord> path = solver.findPath(start, end);
+        if (reachable ? pathCost(board, path, start, end, false, CUT_NEVER) == -1 : !path.empty()) {
+          std::cout << "[FAIL] HPA* (" << start.x << ", " << start.y << ") to (" << end.x << ", " << end.y << "): "
+                    << (reachable ? "invalid path" : "path to an unreachable END") << std::endl;
+          return false;
+        }
+      }
+      // Every other toggle lands on the last column or row of a cluster
+      a = {(int)(rng() % board.width), (int)(rng() % board.height)};
+      if (round % 2 && rng() % 2) a.x = std::min(a.x | 7, board.width - 1);
+      else if (round % 2) a.y = std::min(a.y | 7, board.height - 1);
+      board.cell(a).status = board.isWall(a) ? Board::EMPTY : Board::WALL;
+      hpa.update(a);
+    }
+  }
+  return true;
+}
+
+// The component index joins and splits its components as walls are toggled,
+// and answers connected() as a search would
+bool testComponents() {
+  for (unsigned int seed=1; seed<=30; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(8 + rng() % 40, 8 + rng() % 40, seed, 20 + rng() % 30, 1);
+    ComponentIndex components(board);
+    for (int round=0; round<60; round++) {
+      Coord start, end, a;
+      for (int q=0; q<5; q++) {
+        if (!randomQuery(board, rng, start, end)) continue;
+        bool reachable = dijkstra(board, start, end, false, CUT_NEVER) != -1;
+        if (components.connected(start, end) != reachable) {
+          std::cout << "[FAIL] Components (" << start.x << ", " << start.y << ") to (" << end.x << ", " << end.y << "): "
+                    << (reachable ? "not connected" : "connected") << std::endl;
+          return false;
+        }
+      }
+      if (toggle(board, rng, a, {-1, -1}, {-1, -1})) components.update(a);
+    }
+  }
+  return true;
+}
+
+// The flow field repairs itself after toggled walls and changed terrain costs
+bool testFlowField() {
+  for (unsigned int seed=1; seed<=30; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(8 + rng() % 40, 8 + rng() % 40, seed, rng() % 30, 8);
+    FlowField flow(board);
+    Coord start, end;
+    while (!randomQuery(board, rng, start, end)) {}
+    for (int q=0; q<10; q++) {
+      Coord from = {(int)(rng() % board.width), (int)(rng() % board.height)};
+      if (board.isFree(from) && !check("Flow field", flow, board, from, end)) return false;
+    }
+    for (int round=0; round<40; round++) {
+      Coord a;
+      if (round % 2) {
+        if (toggle(board, rng, a, start, end)) flow.update(a);
+      } else {
+        a = {(int)(rng() % board.width), (int)(rng() % board.height)};
+        board.setCost(a, 1 + rng() % 8);
+        flow.update(a);
+      }
+      if (!check("Flow field", flow, board, start, end)) return false;
+    }
+  }
+  return true;
+}
+
+int main(void) {
+  int queries = 0, hits = 0;
+  for (unsigned int seed=1; seed<=40; seed++) {
+    std::mt19937 rng(seed);
+    Board board = makeBoard(8 + rng() % 40, 8 + rng() % 40, seed, rng() % 35, seed % 2 ? 1 : 8);
+    AStar plain(board);
+    GridAStar<8> eight(board);
+    JPS four(board, JPS::FOUR), jumps(board, JPS::EIGHT);
+    BidirectionalAStar both(board);
+    LandmarkTable table(board, 4, 1);
+    ALTAStar alt(board, table);
+    PathCache cache(board, 16);
+    CornerRule rules[] = {CUT_NEVER, CUT_ONE_FREE, CUT_ALWAYS};
+    const char* ruleNames[] = {"A* (8-connected, never cut)", "A* (8-connected, cut if one side is free)", "A* (8-connected, always cut)"};
+
+    for (int q=0; q<20; q++) {
+      Coord start, end;
+      if (!randomQuery(board, rng, start, end)) continue;
+      queries++;
+      if (!check("A*", plain, board, start, end)) return 1;
+      if (!check("Bidirectional A*", both, board, start, end)) return 1;
+      if (!check("A* (landmarks)", alt, board, start, end)) return 1;
+      for (int r=0; r<3; r++) {
+        eight.corners = rules[r];
+        if (!check(ruleNames[r], eight, board, start, end, true, rules[r])) return 1;
+      }
+      // Jump point search ignores terrain, so only unit-cost boards are checked
+      if (seed % 2) {
+        if (!check("JPS (4-connected)", four, board, start, end)) return 1;
+        if (!check("JPS (8-connected)", jumps, board, start, end, true, CUT_NEVER)) return 1;
+      }
+    }
+
+    // The cache answers repeated queries while walls are toggled under them
+    std::vector<Coord> starts, ends;
+    for (int q=0; q<8; q++) {
+      Coord start, end;
+      if (!randomQuery(board, rng, start, end)) continue;
+      starts.push_back(start);
+      ends.push_back(end);
+    }
+    for (int round=0; round<30; round++) {
+      for (int q=0; q<(int)starts.size(); q++) {
+        queries++;
+        if (!check("A* (cached)", cache, board, starts[q], ends[q])) return 1;
+      }
+      Coord a = {(int)(rng() % board.width), (int)(rng() % board.height)};
+      bool endpoint = false;
+      for (int q=0; q<(int)starts.size(); q++) {
+        if ((a.x == starts[q].x && a.y == starts[q].y) || (a.x == ends[q].x && a.y == ends[q].y)) endpoint = true;
+      }
+      if (endpoint) continue;
+      board.cell(a).status = board.isWall(a) ? Board::EMPTY : Board::WALL;
+      cache.update(a);
+      table.update(a);
+    }
+    hits += cache.hits;
+    for (int q=0; q<(int)starts.size(); q++) {
+      if (!check("A* (landmarks)", alt, board, starts[q], ends[q])) return 1;
+    }
+  }
+  // Cheaper terrain lowers the heuristic, so a cached path can stop being the
+  // shortest without any edit next to what its search expanded
+  Board board(21, 8);
+  for (int i=0; i<21*8; i++) {
+    board.setCost(board.coord(i), 2);
+  }
+  PathCache cache(board);
+  if (!check("A* (cached)", cache, board, {0, 0}, {20, 0})) return 1;
+  for (int x=0; x<21; x++) {
+    board.setCost({x, 3}, 1);
+    cache.update({x, 3});
+  }
+  if (!check("A* (cached)", cache, board, {0, 0}, {20, 0})) return 1;
+
+  if (!testDStarLite()) return 1;
+  if (!testJPSPlus()) return 1;
+  if (!testHPA()) return 1;
+  if (!testComponents()) return 1;
+  if (!testBitBFS()) return 1;
+  if (!testHDAStar()) return 1;
+  if (!testBatch()) return 1;
+  if (!testARAStar()) return 1;
+  if (!testThetaStar()) return 1;
+  if (!testCBS()) return 1;
+  if (!testWHCAStar()) return 1;
+  if (!testFlowField()) return 1;
+
+  std::cout << queries << " queries checked, " << hits << " answered from the cache" << std::endl;
+  return 0;
+}